@@ -18,6 +18,7 @@
 #include <boost/http/file.hpp>
 #include <boost/http/file_mode.hpp>
 #include <boost/http/header_limits.hpp>
+#include <boost/http/hot_fields.hpp>
 #include <boost/http/message_base.hpp>
 #include <boost/http/metadata.hpp>
 #include <boost/http/method.hpp>
@@ -28,6 +29,7 @@
 #include <boost/http/response.hpp>
 #include <boost/http/response_base.hpp>
 #include <boost/http/serializer.hpp>
+#include <boost/http/shared_fields.hpp>
 #include <boost/http/static_request.hpp>
 #include <boost/http/static_response.hpp>
 #include <boost/http/status.hpp>
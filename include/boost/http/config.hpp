@@ -118,6 +118,10 @@ struct parser_config_impl : parser_config
 
 /** Serializer configuration settings.
 
+    Content-Encoding is applied only to messages
+    which have no Content-Length field, because the
+    encoding changes the size of the body.
+
     @see @ref make_serializer_config,
          @ref serializer.
 */
@@ -67,6 +67,11 @@ struct header
     field unknown_field =
         static_cast<field>(0);
 
+    // id of an erased entry awaiting compaction
+    static constexpr
+    field dead_field =
+        static_cast<field>(-1);
+
     struct entry
     {
         offset_type np;   // name pos
@@ -131,6 +136,7 @@ struct header
     offset_type size = 0;
     offset_type count = 0;
     offset_type prefix = 0;
+    offset_type dead = 0;
 
     http::version version =
         http::version::http_1_1;
@@ -188,6 +194,17 @@ public:
     void copy_table(void*, std::size_t) const noexcept;
     void copy_table(void*) const noexcept;
     void assign_to(header&) const noexcept;
+    BOOST_HTTP_DECL void compact() noexcept;
+    BOOST_HTTP_DECL std::size_t next_live(std::size_t) const noexcept;
+    BOOST_HTTP_DECL std::size_t prev_live(std::size_t) const noexcept;
+
+    // fields of an external block, indexed after
+    // the fields of this header. A block field is
+    // shadowed by a live field of the same name.
+    BOOST_HTTP_DECL bool shadows(header const&, std::size_t) const noexcept;
+    BOOST_HTTP_DECL std::size_t next_visible(header const*, std::size_t) const noexcept;
+    BOOST_HTTP_DECL std::size_t prev_visible(header const*, std::size_t) const noexcept;
+    BOOST_HTTP_DECL std::size_t visible_count(header const*) const noexcept;
 
     // metadata
 
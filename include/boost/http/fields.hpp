@@ -80,6 +80,40 @@ public:
     {
     }
 
+    /** Constructor.
+
+        Constructs an empty container which
+        obtains its storage from `mr`. The
+        resource is retained by the container
+        and exchanged by @ref swap and move
+        assignment. Copies do not inherit it.
+
+        @par Example
+        @code
+        std::pmr::monotonic_buffer_resource mr;
+        fields fs(&mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "\r\n" && this->get_memory_resource() == mr
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource to use. The
+        caller is responsible for ensuring that the
+        lifetime of the resource extends until the
+        container is destroyed.
+    */
+    explicit
+    fields(
+        std::pmr::memory_resource* mr) noexcept
+        : fields_base(detail::kind::fields, mr)
+    {
+    }
+
 
     /** Constructor.
 
@@ -297,6 +331,7 @@ public:
     swap(fields& other) noexcept
     {
         h_.swap(other.h_);
+        std::swap(mr_, other.mr_);
         std::swap(max_cap_, other.max_cap_);
     }
 
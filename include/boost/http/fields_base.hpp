@@ -17,7 +17,10 @@
 #include <boost/http/detail/header.hpp>
 #include <boost/core/detail/string_view.hpp>
 
+#include <initializer_list>
 #include <iosfwd>
+#include <memory_resource>
+#include <utility>
 
 namespace boost {
 namespace http {
@@ -30,14 +33,29 @@ namespace http {
     containers are not invalidated when
     the underlying container is modified.
 
+    @par Allocation
+
+    Containers which own their buffer obtain it
+    from an optional `std::pmr::memory_resource`.
+    When no resource is supplied, the global
+    `operator new[]` is used. The buffer grows
+    geometrically, so a sequence of insertions
+    performs a logarithmic number of allocations.
+
     @note HTTP field names are case-insensitive.
 */
 class fields_base
 {
     detail::header h_;
+    // fields visible after ours, not owned
+    detail::header const* ext_ = nullptr;
+    std::pmr::memory_resource* mr_ = nullptr;
     std::size_t max_cap_ =
         std::numeric_limits<std::size_t>::max();
     bool external_storage_ = false;
+    bool deferred_ = false;
+    // changes on every modification
+    std::size_t gen_ = 1;
 
     using entry =
         detail::header::entry;
@@ -52,6 +70,7 @@ class fields_base
         fields_base& self_;
         offset_type new_prefix_;
         char* buf_ = nullptr;
+        std::size_t cap_ = 0;
 
     public:
         prefix_op_t(
@@ -79,6 +98,11 @@ class fields_base
     fields_base(
         detail::kind k) noexcept;
 
+    BOOST_HTTP_DECL
+    fields_base(
+        detail::kind k,
+        std::pmr::memory_resource* mr) noexcept;
+
     BOOST_HTTP_DECL
     fields_base(
         detail::kind k,
@@ -93,7 +117,8 @@ class fields_base
     BOOST_HTTP_DECL
     explicit
     fields_base(
-        detail::header const& h);
+        detail::header const& h,
+        std::pmr::memory_resource* mr = nullptr);
 
     BOOST_HTTP_DECL
     fields_base(
@@ -253,20 +278,65 @@ public:
     rend() const noexcept;
 
     /** Return a string view representing the serialized data.
+
+        If compaction is pending, the buffer
+        is compacted first.
+
+        @see
+            @ref set_deferred_compaction.
     */
     core::string_view
-    buffer() const noexcept
+    buffer() noexcept
     {
+        if(h_.dead != 0)
+            compact();
+        return core::string_view(
+            h_.cbuf, h_.size);
+    }
+
+    /** Return a string view representing the serialized data.
+
+        The buffer of an object with erasures
+        awaiting compaction still holds the
+        erased fields, so it cannot be returned
+        by a const observer. Call @ref compact
+        or the non-const overload first.
+
+        @par Exception Safety
+        Exception thrown if compaction is pending.
+
+        @throw std::logic_error
+        Compaction is pending.
+
+        @see
+            @ref compact,
+            @ref set_deferred_compaction.
+    */
+    core::string_view
+    buffer() const
+    {
+        if(h_.dead != 0)
+            detail::throw_logic_error();
         return core::string_view(
             h_.cbuf, h_.size);
     }
 
     /** Return the number of fields in the container.
+
+        For a response which references shared
+        fields, this includes the fields of the
+        block which are not shadowed by a field
+        of the response.
+
+        @see
+            @ref response_base::set_shared_fields.
     */
     std::size_t
     size() const noexcept
     {
-        return h_.count;
+        if(! ext_)
+            return h_.count - h_.dead;
+        return h_.visible_count(ext_);
     }
 
     /** Return the value of a field, or throws an exception.
@@ -505,6 +575,18 @@ public:
         return h_.cap;
     }
 
+    /** Return the memory resource used by the container.
+
+        @return The resource supplied at construction,
+        or `nullptr` if the container allocates with
+        the global `operator new[]`.
+    */
+    std::pmr::memory_resource*
+    get_memory_resource() const noexcept
+    {
+        return mr_;
+    }
+
     /** Clear contents while preserving the capacity.
 
         In the case of response and request
@@ -588,6 +670,100 @@ public:
     void
     shrink_to_fit();
 
+    /** Return true if compaction is deferred.
+
+        @see
+            @ref set_deferred_compaction.
+    */
+    bool
+    deferred_compaction() const noexcept
+    {
+        return deferred_;
+    }
+
+    /** Enable or disable deferred compaction.
+
+        Normally, erasing a header moves the
+        remainder of the buffer to close the gap,
+        so that each edit costs time linear in the
+        size of the buffer. When deferred compaction
+        is enabled, @ref erase by name or name
+        constant and @ref set by name or name
+        constant instead mark the removed headers
+        as erased and append any replacement at
+        the end. Lookups and iteration skip the
+        erased headers, so edits and lookups may
+        be interleaved freely. The buffer is
+        compacted once, in place, when @ref compact
+        or @ref buffer is called on a non-const
+        object, when the container is copied, or
+        when capacity runs out. This makes a long
+        run of edits cost amortized constant time
+        each. The serializer leaves out the erased
+        headers without modifying the message.
+
+        Headers which affect the metadata of
+        the message, such as Content-Length or
+        Connection, are always edited in place.
+
+        While compaction is pending, erased headers
+        continue to occupy capacity, all iterators
+        are invalidated by any modification, and
+        the const overload of @ref buffer throws.
+        Const observers never compact, so they may
+        be called concurrently.
+
+        Disabling deferred compaction compacts
+        the buffer.
+
+        @par Example
+        @code
+        response res;
+        res.set_deferred_compaction(true);
+        res.erase(field::keep_alive);
+        res.erase(field::proxy_authenticate);
+        res.set(field::vary, "Origin");
+        res.set_deferred_compaction(false);
+        @endcode
+
+        @par Complexity
+        Constant, or linear in `this->buffer().size()`
+        when `value == false`.
+
+        @param value `true` to defer compaction.
+    */
+    void
+    set_deferred_compaction(
+        bool value) noexcept
+    {
+        deferred_ = value;
+        if(! value)
+            compact();
+    }
+
+    /** Apply pending erasures.
+
+        The fields erased while compaction was
+        deferred are removed from the buffer,
+        in place. Deferred compaction remains
+        enabled if it was enabled. This has no
+        effect when no compaction is pending.
+
+        @par Complexity
+        Linear in `this->buffer().size()`.
+
+        @see
+            @ref set_deferred_compaction.
+    */
+    void
+    compact() noexcept
+    {
+        if(h_.dead == 0)
+            return;
+        ++gen_;
+        h_.compact();
+    }
+
     //--------------------------------------------
     //
     // Modifiers
@@ -792,6 +968,103 @@ public:
             ec);
     }
 
+    /** Append a list of headers.
+
+        This function appends each header in
+        `init`, in order. Existing headers are
+        not changed. All values are validated
+        first and the buffer is grown at most
+        once for the entire list, so this is
+        preferred over a sequence of calls to
+        @ref append when building a message
+        with many fields.
+
+        Any leading or trailing whitespace in a
+        value is ignored.
+
+        No iterators are invalidated.
+
+        @par Example
+        @code
+        response res;
+
+        res.append({
+            { field::server, "Boost" },
+            { field::content_type, "text/html" },
+            { field::cache_control, "no-cache" } });
+        @endcode
+
+        @par Complexity
+        Linear in the total size of the names
+        and values in `init`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown on invalid input.
+        Exception thrown if max capacity exceeded.
+
+        @throw system_error
+        Input is invalid.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param init The list of field name
+        constants and values to append.
+    */
+    void
+    append(
+        std::initializer_list<
+            std::pair<field, core::string_view>> init)
+    {
+        system::error_code ec;
+        append(init, ec);
+        if(ec)
+            detail::throw_system_error(ec);
+    }
+
+    /** Append a list of headers.
+
+        This function appends each header in
+        `init`, in order. Existing headers are
+        not changed. All values are validated
+        first and the buffer is grown at most
+        once for the entire list. If any value
+        is invalid, no headers are appended.
+
+        Any leading or trailing whitespace in a
+        value is ignored.
+
+        No iterators are invalidated.
+
+        @par Complexity
+        Linear in the total size of the names
+        and values in `init`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exception thrown if max capacity exceeded.
+
+        @throw std::length_error
+        Max capacity would be exceeded.
+
+        @param init The list of field name
+        constants and values to append.
+
+        @param ec Set to the error if input is invalid.
+    */
+    void
+    append(
+        std::initializer_list<
+            std::pair<field, core::string_view>> init,
+        system::error_code& ec)
+    {
+        append_impl(
+            init.begin(), init.size(), ec);
+    }
+
     /** Insert a header.
 
         If a matching header with the same name
@@ -804,6 +1077,11 @@ public:
         All iterators that are equal to `before`
         or come after are invalidated.
 
+        When `before` refers to a field of a
+        shared block, or to the end, the header
+        is inserted after the last header owned
+        by the container.
+
         @par Example
         @code
         request req;
@@ -855,6 +1133,11 @@ public:
         All iterators that are equal to `before`
         or come after are invalidated.
 
+        When `before` refers to a field of a
+        shared block, or to the end, the header
+        is inserted after the last header owned
+        by the container.
+
         @par Example
         @code
         request req;
@@ -905,6 +1188,11 @@ public:
         All iterators that are equal to `before`
         or come after are invalidated.
 
+        When `before` refers to a field of a
+        shared block, or to the end, the header
+        is inserted after the last header owned
+        by the container.
+
         @par Example
         @code
         request req;
@@ -956,6 +1244,11 @@ public:
         All iterators that are equal to `before`
         or come after are invalidated.
 
+        When `before` refers to a field of a
+        shared block, or to the end, the header
+        is inserted after the last header owned
+        by the container.
+
         @par Example
         @code
         request req;
@@ -1003,6 +1296,11 @@ public:
         All iterators that are equal to `it`
         or come after are invalidated.
 
+        @par Preconditions
+        `it` does not refer to a field of the
+        block referenced with
+        @ref response_base::set_shared_fields.
+
         @par Complexity
         Linear in `name.size() + value.size()`.
 
@@ -1072,6 +1370,13 @@ public:
         Any leading or trailing whitespace in the
         new value is ignored.
 
+        When `it` refers to a field of the block
+        referenced with
+        @ref response_base::set_shared_fields,
+        the block is not modified; instead the
+        field is set on the response, which
+        shadows the field of the block.
+
         @par Complexity
 
         @par Exception Safety
@@ -1106,6 +1411,13 @@ public:
         Any leading or trailing whitespace in the
         new value is ignored.
 
+        When `it` refers to a field of the block
+        referenced with
+        @ref response_base::set_shared_fields,
+        the block is not modified; instead the
+        field is set on the response, which
+        shadows the field of the block.
+
         @par Complexity
 
         @par Exception Safety
@@ -1358,6 +1670,25 @@ private:
         std::size_t before,
         system::error_code& ec);
 
+    std::size_t
+    tombstone_all(
+        std::size_t i0,
+        std::size_t i1,
+        field id) noexcept;
+
+    std::size_t
+    tombstone_all(
+        std::size_t i0,
+        std::size_t i1,
+        core::string_view name) noexcept;
+
+    BOOST_HTTP_DECL
+    void
+    append_impl(
+        std::pair<field, core::string_view> const* p,
+        std::size_t n,
+        system::error_code& ec);
+
     void
     insert_unchecked(
         optional<field> id,
@@ -1390,6 +1721,18 @@ private:
     std::size_t
     length(
         std::size_t i) const noexcept;
+
+    char*
+    allocate(std::size_t n);
+
+    void
+    deallocate(
+        char* p,
+        std::size_t n) noexcept;
+
+    std::size_t
+    next_capacity(
+        std::size_t n) const noexcept;
 };
 
 } // http
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_HOT_FIELDS_HPP
+#define BOOST_HTTP_HOT_FIELDS_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http {
+
+/** Request fields which are read on most requests.
+
+    These values are found with a single pass
+    over the fields of a request. A request
+    keeps them until it is next modified, so
+    the conditional request and static file
+    code can read them without searching the
+    fields again.
+
+    The string views reference the buffer of
+    the request and are invalidated by any
+    modification of it. When a field appears
+    more than once, the views refer to the
+    first occurrence.
+
+    @see
+        @ref request_base::hot.
+*/
+struct hot_fields
+{
+    /** The value of the Host field, or empty.
+    */
+    core::string_view host;
+
+    /** The value of the Range field, or empty.
+    */
+    core::string_view range;
+
+    /** The value of the If-Range field, or empty.
+    */
+    core::string_view if_range;
+
+    /** The value of the Accept-Encoding field, or empty.
+    */
+    core::string_view accept_encoding;
+
+    /** The value of the Cookie field, or empty.
+    */
+    core::string_view cookie;
+
+    /** The value of the Authorization field, or empty.
+    */
+    core::string_view authorization;
+
+    /** The number of If-Match fields.
+    */
+    std::size_t if_match = 0;
+
+    /** The number of If-None-Match fields.
+    */
+    std::size_t if_none_match = 0;
+
+    /** The If-Modified-Since date, in seconds since the epoch.
+
+        This is meaningful only when
+        @ref has_if_modified_since is `true`.
+    */
+    std::uint64_t if_modified_since = 0;
+
+    /** The If-Unmodified-Since date, in seconds since the epoch.
+
+        This is meaningful only when
+        @ref has_if_unmodified_since is `true`.
+    */
+    std::uint64_t if_unmodified_since = 0;
+
+    /** True if If-Modified-Since holds a valid HTTP-date.
+    */
+    bool has_if_modified_since = false;
+
+    /** True if If-Unmodified-Since holds a valid HTTP-date.
+    */
+    bool has_if_unmodified_since = false;
+};
+
+} // http
+} // boost
+
+#endif
@@ -25,14 +25,17 @@ namespace http {
 class fields_base::iterator
 {
     detail::header const* ph_ = nullptr;
+    detail::header const* pe_ = nullptr;
     std::size_t i_ = 0;
 
     friend class fields_base;
 
     iterator(
         detail::header const* ph,
+        detail::header const* pe,
         std::size_t i) noexcept
         : ph_(ph)
+        , pe_(pe)
         , i_(i)
     {
     }
@@ -85,8 +88,11 @@ public:
     iterator&
     operator++() noexcept
     {
-        BOOST_ASSERT(i_ < ph_->count);
+        BOOST_ASSERT(i_ < ph_->count +
+            (pe_ ? pe_->count : 0));
         ++i_;
+        if(ph_->dead != 0 || pe_)
+            i_ = ph_->next_visible(pe_, i_);
         return *this;
     }
 
@@ -102,6 +108,8 @@ public:
     operator--() noexcept
     {
         BOOST_ASSERT(i_ > 0);
+        if(ph_->dead != 0 || pe_)
+            i_ = ph_->prev_visible(pe_, i_);
         --i_;
         return *this;
     }
@@ -120,14 +128,17 @@ public:
 class fields_base::reverse_iterator
 {
     detail::header const* ph_ = nullptr;
+    detail::header const* pe_ = nullptr;
     std::size_t i_ = 0;
 
     friend class fields_base;
 
     reverse_iterator(
         detail::header const* ph,
+        detail::header const* pe,
         std::size_t i) noexcept
         : ph_(ph)
+        , pe_(pe)
         , i_(i)
     {
     }
@@ -152,6 +163,7 @@ public:
     reverse_iterator(
         iterator it) noexcept
         : ph_(it.ph_)
+        , pe_(it.pe_)
         , i_(it.i_)
     {
     }
@@ -190,6 +202,8 @@ public:
     {
         BOOST_ASSERT(i_ > 0);
         --i_;
+        if(ph_->dead != 0 || pe_)
+            i_ = ph_->prev_visible(pe_, i_);
         return *this;
     }
 
@@ -204,7 +218,10 @@ public:
     reverse_iterator&
     operator--() noexcept
     {
-        BOOST_ASSERT(i_ < ph_->count);
+        BOOST_ASSERT(i_ < ph_->count +
+            (pe_ ? pe_->count : 0));
+        if(ph_->dead != 0 || pe_)
+            i_ = ph_->next_visible(pe_, i_);
         ++i_;
         return *this;
     }
@@ -227,6 +244,7 @@ public:
 class fields_base::subrange
 {
     detail::header const* ph_ = nullptr;
+    detail::header const* pe_ = nullptr;
     std::size_t i_ = 0;
 
     friend class fields_base;
@@ -234,8 +252,10 @@ class fields_base::subrange
 
     subrange(
         detail::header const* ph,
+        detail::header const* pe,
         std::size_t i) noexcept
         : ph_(ph)
+        , pe_(pe)
         , i_(i)
     {
     }
@@ -274,6 +294,7 @@ class fields_base::subrange::
     iterator
 {
     detail::header const* ph_ = nullptr;
+    detail::header const* pe_ = nullptr;
     std::size_t i_ = 0;
 
     friend class fields_base::subrange;
@@ -281,12 +302,14 @@ class fields_base::subrange::
     BOOST_HTTP_DECL
     iterator(
         detail::header const* ph,
+        detail::header const* pe,
         std::size_t i) noexcept;
 
     // end
     BOOST_HTTP_DECL
     iterator(
-        detail::header const* ph) noexcept;
+        detail::header const* ph,
+        detail::header const* pe) noexcept;
 
 public:
     using value_type = std::string;
@@ -307,7 +330,7 @@ public:
     fields_base::
     iterator() const noexcept
     {
-        return {ph_, i_};
+        return {ph_, pe_, i_};
     }
 
     bool
@@ -359,7 +382,7 @@ subrange::
 begin() const noexcept ->
     iterator
 {
-    return {ph_, i_};
+    return {ph_, pe_, i_};
 }
 
 inline
@@ -369,7 +392,7 @@ subrange::
 end() const noexcept ->
     iterator
 {
-    return {ph_};
+    return {ph_, pe_};
 }
 
 //------------------------------------------------
@@ -393,7 +416,10 @@ fields_base::
 begin() const noexcept ->
     iterator
 {
-    return iterator(&h_, 0);
+    if(h_.dead != 0 || ext_)
+        return iterator(&h_, ext_,
+            h_.next_visible(ext_, 0));
+    return iterator(&h_, ext_, 0);
 }
 
 inline
@@ -402,7 +428,8 @@ fields_base::
 end() const noexcept ->
     iterator
 {
-    return iterator(&h_, h_.count);
+    return iterator(&h_, ext_, h_.count +
+        (ext_ ? ext_->count : 0));
 }
 
 inline
@@ -411,6 +438,9 @@ fields_base::
 rbegin() const noexcept ->
     reverse_iterator
 {
+    if(h_.dead != 0 || ext_)
+        return reverse_iterator(&h_, ext_,
+            h_.prev_visible(ext_, end().i_));
     return reverse_iterator(end());
 }
 
@@ -420,7 +450,7 @@ fields_base::
 rend() const noexcept ->
     reverse_iterator
 {
-    return reverse_iterator(begin());
+    return reverse_iterator(&h_, ext_, 0);
 }
 
 } // http
@@ -75,6 +75,40 @@ public:
     */
     request() noexcept = default;
 
+    /** Constructor.
+
+        Constructs a default request which
+        obtains its storage from `mr`. The
+        resource is retained by the container
+        and exchanged by @ref swap and move
+        assignment. Copies do not inherit it.
+
+        @par Example
+        @code
+        std::pmr::monotonic_buffer_resource mr;
+        request req(&mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "GET / HTTP/1.1\r\n\r\n" && this->get_memory_resource() == mr
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource to use. The
+        caller is responsible for ensuring that the
+        lifetime of the resource extends until the
+        container is destroyed.
+    */
+    explicit
+    request(
+        std::pmr::memory_resource* mr) noexcept
+        : request_base(mr)
+    {
+    }
+
     /** Constructor.
 
         Constructs a request from the string `s`,
@@ -408,6 +442,9 @@ public:
     swap(request& other) noexcept
     {
         h_.swap(other.h_);
+        ++gen_;
+        ++other.gen_;
+        std::swap(mr_, other.mr_);
         std::swap(max_cap_, other.max_cap_);
     }
 
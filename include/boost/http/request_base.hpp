@@ -12,6 +12,7 @@
 #define BOOST_HTTP_REQUEST_BASE_HPP
 
 #include <boost/http/detail/config.hpp>
+#include <boost/http/hot_fields.hpp>
 #include <boost/http/message_base.hpp>
 
 namespace boost {
@@ -30,6 +31,11 @@ class request_base
     friend class request;
     friend class static_request;
 
+    // found by hot(), current
+    // while hot_gen_ == gen_
+    hot_fields hot_;
+    std::size_t hot_gen_ = 0;
+
     request_base() noexcept
         : message_base(detail::kind::request)
     {
@@ -41,6 +47,13 @@ class request_base
     {
     }
 
+    explicit
+    request_base(
+        std::pmr::memory_resource* mr) noexcept
+        : message_base(detail::kind::request, mr)
+    {
+    }
+
     request_base(
         void* storage,
         std::size_t cap) noexcept
@@ -49,6 +62,13 @@ class request_base
     {
     }
 
+    // the copy finds its own hot fields
+    request_base(
+        request_base const& other)
+        : message_base(other)
+    {
+    }
+
 public:
     //--------------------------------------------
     //
@@ -289,7 +309,70 @@ public:
     void
     set_expect_100_continue(bool b);
 
+    //--------------------------------------------
+
+    /** Return the frequently read fields.
+
+        The fields are found with one pass over
+        the request on the first call after
+        construction or a modification, and are
+        kept until the request is next modified.
+
+        @par Complexity
+        Constant, or linear in `this->size()`
+        when the fields must be found again.
+
+        @return A reference to the fields, which
+        is valid until the request is modified.
+
+        @see
+            @ref hot_fields.
+    */
+    hot_fields const&
+    hot() noexcept
+    {
+        if(hot_gen_ != gen_)
+        {
+            find_hot_fields(hot_);
+            hot_gen_ = gen_;
+        }
+        return hot_;
+    }
+
+    /** Return the frequently read fields.
+
+        If the fields were found since the last
+        modification of the request they are
+        returned directly. Otherwise they are
+        found again without being kept, so that
+        a const request may still be read from
+        several threads at once.
+
+        @par Complexity
+        Constant, or linear in `this->size()`
+        when the fields must be found again.
+
+        @return The fields.
+
+        @see
+            @ref hot_fields.
+    */
+    hot_fields
+    hot() const noexcept
+    {
+        if(hot_gen_ == gen_)
+            return hot_;
+        hot_fields v;
+        find_hot_fields(v);
+        return v;
+    }
+
 private:
+    BOOST_HTTP_DECL
+    void
+    find_hot_fields(
+        hot_fields& v) const noexcept;
+
     BOOST_HTTP_DECL
     void
     set_start_line_impl(
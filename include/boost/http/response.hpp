@@ -77,6 +77,40 @@ public:
     */
     response() noexcept = default;
 
+    /** Constructor.
+
+        Constructs a default response which
+        obtains its storage from `mr`. The
+        resource is retained by the container
+        and exchanged by @ref swap and move
+        assignment. Copies do not inherit it.
+
+        @par Example
+        @code
+        std::pmr::monotonic_buffer_resource mr;
+        response res(&mr);
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer() == "HTTP/1.1 200 OK\r\n\r\n" && this->get_memory_resource() == mr
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param mr The memory resource to use. The
+        caller is responsible for ensuring that the
+        lifetime of the resource extends until the
+        container is destroyed.
+    */
+    explicit
+    response(
+        std::pmr::memory_resource* mr) noexcept
+        : response_base(mr)
+    {
+    }
+
     /** Constructor.
 
         Constructs a response from the string `s`,
@@ -339,6 +373,8 @@ public:
         response const& r)
     {
         copy_impl(r.h_);
+        sf_ = r.sf_;
+        attach_shared_fields();
         return *this;
     }
 
@@ -373,6 +409,8 @@ public:
         response_base const& r)
     {
         copy_impl(r.h_);
+        sf_ = r.sf_;
+        attach_shared_fields();
         return *this;
     }
 
@@ -404,6 +442,9 @@ public:
     swap(response& other) noexcept
     {
         h_.swap(other.h_);
+        sf_.swap(other.sf_);
+        std::swap(ext_, other.ext_);
+        std::swap(mr_, other.mr_);
         std::swap(max_cap_, other.max_cap_);
     }
 
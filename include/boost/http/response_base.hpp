@@ -14,6 +14,7 @@
 
 #include <boost/http/detail/config.hpp>
 #include <boost/http/message_base.hpp>
+#include <boost/http/shared_fields.hpp>
 #include <boost/http/status.hpp>
 
 namespace boost {
@@ -32,6 +33,8 @@ class response_base
     friend class response;
     friend class static_response;
 
+    http::shared_fields sf_;
+
     response_base() noexcept
         : message_base(detail::kind::response)
     {
@@ -43,6 +46,13 @@ class response_base
     {
     }
 
+    explicit
+    response_base(
+        std::pmr::memory_resource* mr) noexcept
+        : message_base(detail::kind::response, mr)
+    {
+    }
+
     response_base(
         void* storage,
         std::size_t cap) noexcept
@@ -51,6 +61,23 @@ class response_base
     {
     }
 
+    response_base(
+        response_base const& other)
+        : message_base(other)
+        , sf_(other.sf_)
+    {
+        attach_shared_fields();
+    }
+
+    // make the block visible through fields_base
+    void
+    attach_shared_fields() noexcept
+    {
+        ext_ = sf_.empty() ? nullptr :
+            &static_cast<fields_base const&>(
+                sf_.get()).h_;
+    }
+
 public:
     //--------------------------------------------
     //
@@ -88,6 +115,17 @@ public:
         return h_.res.status_int;
     }
 
+    /** Return the shared fields referenced by the response.
+
+        @see
+            @ref set_shared_fields.
+    */
+    http::shared_fields const&
+    get_shared_fields() const noexcept
+    {
+        return sf_;
+    }
+
     //--------------------------------------------
     //
     // Modifiers
@@ -220,6 +258,51 @@ public:
             v);
     }
 
+    /** Reference a block of shared fields.
+
+        The response will reference `sf`, replacing
+        any previously referenced block. The fields
+        in the block are not copied.
+
+        The fields of the response form an overlay
+        on the block. A field of the block is
+        shadowed by any field of the response with
+        the same name, and is then neither seen nor
+        serialized. The other fields of the block
+        follow the fields of the response when
+        iterating, are seen by lookups such as
+        `find`, @ref exists or @ref count, and are
+        counted by @ref size; the serializer emits
+        them after the fields of the response,
+        without copying. Erasing a field of the
+        response uncovers the field of the block
+        with the same name, if any. The fields of
+        the block cannot be modified through the
+        response, and @ref buffer only returns
+        the fields of the response.
+
+        @par Example
+        @code
+        static shared_fields const common = make_common_fields();
+
+        response res(status::ok);
+        res.set_shared_fields(common);
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @param sf The block to reference. Pass a
+        default-constructed object to clear it.
+    */
+    void
+    set_shared_fields(
+        http::shared_fields sf) noexcept
+    {
+        sf_ = std::move(sf);
+        attach_shared_fields();
+    }
+
 private:
     BOOST_HTTP_DECL
     void
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_ATOMIC_FLAT_ROUTER_HPP
+#define BOOST_HTTP_SERVER_ATOMIC_FLAT_ROUTER_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/flat_router.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4251) // shared_ptr needs dll-interface
+#endif
+
+/** A flat_router which can be replaced while in use.
+
+    This holds the current @ref flat_router and
+    publishes replacements atomically. Dispatch
+    takes a snapshot of the routes when it is
+    called: a dispatch in progress completes on
+    the routes it started with, while dispatches
+    which begin after @ref store see the new ones.
+    The old routes are destroyed when the last
+    dispatch using them completes.
+
+    Each thread which dispatches is given its own
+    lease on the current routes, and a dispatch
+    shares that lease. So dispatch reads one version
+    counter and updates a reference count which
+    only its thread uses; no lock is taken and no
+    count is shared between threads. The first
+    dispatch on a thread after @ref store takes a
+    lock to obtain a new lease. @ref store takes
+    the same lock.
+
+    This object owns the leases and threads only
+    observe them. @ref store and the destructor
+    release every lease, so the old routes are
+    destroyed as soon as no dispatch uses them,
+    even on threads which never dispatch again.
+
+    @par Example
+    @code
+    atomic_flat_router routes(flat_router(load_routes(config)));
+
+    // worker threads
+    co_await routes.dispatch(method, url, params);
+
+    // on reload, from any thread
+    routes.store(flat_router(load_routes(new_config)));
+    @endcode
+
+    @par Thread Safety
+    All member functions may be called concurrently.
+*/
+class BOOST_HTTP_DECL
+    atomic_flat_router
+{
+    struct lease;
+
+    std::uint64_t const id_;
+    std::atomic<std::uint64_t> version_;
+    mutable std::mutex m_;
+    std::shared_ptr<flat_router::impl> p_;
+    mutable std::vector<std::shared_ptr<lease>> leases_;
+
+    std::shared_ptr<flat_router::impl>
+    snapshot() const;
+
+public:
+    /** Constructor.
+
+        @param fr The initial routes.
+    */
+    explicit
+    atomic_flat_router(
+        flat_router fr) noexcept;
+
+    atomic_flat_router(
+        atomic_flat_router const&) = delete;
+
+    atomic_flat_router& operator=(
+        atomic_flat_router const&) = delete;
+
+    /** Return the current routes.
+    */
+    flat_router
+    load() const;
+
+    /** Replace the current routes.
+
+        Dispatches which have already begun are
+        not affected.
+
+        @param fr The new routes.
+    */
+    void
+    store(flat_router fr);
+
+    /** Dispatch a request on the current routes.
+
+        @see flat_router::dispatch
+    */
+    route_task
+    dispatch(
+        http::method verb,
+        urls::url_view const& url,
+        route_params_base& p) const;
+
+    /** Dispatch a request on the current routes.
+
+        @see flat_router::dispatch
+    */
+    route_task
+    dispatch(
+        std::string_view verb,
+        urls::url_view const& url,
+        route_params_base& p) const;
+};
+
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // http
+} // boost
+
+#endif
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_AUTO_ETAG_HPP
+#define BOOST_HTTP_SERVER_AUTO_ETAG_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/router.hpp>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace http {
+
+/** Options for @ref auto_etag.
+*/
+struct auto_etag_options
+{
+    /** The largest body which is buffered and hashed.
+
+        A body which grows past this size is sent
+        as it is written, without an ETag.
+    */
+    std::size_t limit = 65536;
+};
+
+namespace detail {
+
+// Holds the body written by a handler wrapped in
+// auto_etag, then sends it with an ETag, or sends
+// 304 when the request already has the body.
+class BOOST_HTTP_DECL etag_body_sink
+{
+    route_params& rp_;
+    capy::any_buffer_sink& next_;
+    std::string buf_;
+    std::size_t size_ = 0;
+    std::size_t limit_;
+    bool direct_ = false; // writes pass through
+    bool done_ = false;
+
+    capy::io_task<> finish();
+    capy::io_task<> spill();
+
+public:
+    etag_body_sink(
+        route_params& rp,
+        capy::any_buffer_sink& next,
+        std::size_t limit) noexcept;
+
+    std::size_t
+    prepare(
+        capy::mutable_buffer* arr,
+        std::size_t max_count);
+
+    capy::io_task<>
+    commit(std::size_t n);
+
+    capy::io_task<>
+    commit(std::size_t n, bool eof);
+
+    capy::io_task<>
+    commit_eof();
+
+    // Send a body which the handler did not end
+    capy::io_task<>
+    flush();
+};
+
+} // detail
+
+/** A handler which adds an ETag to the responses of another.
+
+    The wrapped handler writes its response body as
+    usual. The body is held in memory instead of being
+    sent, and when the handler ends it a strong ETag
+    computed from the content is added to the response,
+    unless the handler set one. If the request then has
+    a matching `If-None-Match` or `If-Modified-Since`
+    field, the body is discarded and 304 Not Modified
+    is sent in its place. Nothing is serialized before
+    this decision is made.
+
+    Only 200 responses are tagged. A body larger than
+    @ref auto_etag_options::limit is sent unchanged as
+    soon as it grows past the limit.
+
+    @par Example
+    @code
+    router r;
+    r.add( method::get, "/api/items", auto_etag(
+        []( route_params& p ) -> route_task
+        {
+            p.res.set( field::content_type, "application/json" );
+            auto [ec, n] = co_await p.res_body.write(
+                capy::make_buffer( items_json() ), true );
+            if( ec )
+                co_return route_error( ec );
+            co_return route_done;
+        } ) );
+    @endcode
+
+    @see
+        @ref auto_etag_options,
+        @ref etag.
+*/
+template<class Handler>
+class auto_etag
+{
+    Handler h_;
+    auto_etag_options opts_;
+
+public:
+    /** Constructor.
+
+        @param h The handler to wrap. It is invoked
+        with `route_params&` and returns
+        @ref route_result or @ref route_task.
+
+        @param opts The options.
+    */
+    explicit
+    auto_etag(
+        Handler h,
+        auto_etag_options const& opts = {})
+        : h_(std::move(h))
+        , opts_(opts)
+    {
+    }
+
+    /** Invoke the wrapped handler.
+    */
+    route_task
+    operator()(route_params& rp) const
+    {
+        // Put the sink back however the handler exits
+        struct restore
+        {
+            route_params& rp;
+            capy::any_buffer_sink& next;
+
+            ~restore()
+            {
+                rp.res_body = std::move(next);
+            }
+        };
+
+        capy::any_buffer_sink next = std::move(rp.res_body);
+        detail::etag_body_sink sink(rp, next, opts_.limit);
+        restore guard{ rp, next };
+        rp.res_body = capy::any_buffer_sink(sink);
+
+        route_result rv;
+        if constexpr(detail::returns_route_task<
+                Handler const&, route_params&>)
+            rv = co_await h_(rp);
+        else
+            rv = h_(rp);
+
+        auto [ec] = co_await sink.flush();
+        if(ec)
+            co_return route_error(ec);
+        co_return rv;
+    }
+};
+
+} // http
+} // boost
+
+#endif
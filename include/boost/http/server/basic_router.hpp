@@ -174,6 +174,12 @@ private:
     occurred. Failures are represented by error codes for which
     `system::error_code::failed()` returns `true`.
 
+    Handlers may return either a @ref route_task or a @ref route_result.
+    A handler which never needs to suspend, such as pass-through
+    middleware, can return `route_result` directly; it is then called
+    without creating a coroutine frame. This applies to error and
+    exception handlers as well.
+
     When a failing error code is produced and remains unhandled, the
     router enters error-dispatching mode. In this mode, only error
     handlers are invoked. Error handlers are registered globally or
@@ -228,6 +234,15 @@ private:
     is added via @ref use. This limit ensures that @ref flat_router dispatch
     never overflows its fixed-size tracking arrays.
 
+    @par Matching Cost
+
+    Parameters match the longest text first and give way as needed
+    for the rest of the pattern to match. To keep a pattern with
+    several multi-segment parameters, such as `"/*a/*b/x"`, from
+    backtracking without bound, matching one pattern against a path
+    of `n` characters takes at most a fixed multiple of `n` steps.
+    A pattern which needs more does not match.
+
     @par Constraints
 
     `Params` must be publicly derived from @ref route_params_base.
@@ -243,12 +258,17 @@ class basic_router : public detail::router_base
     static inline constexpr char handler_kind =
         []() -> char
         {
-            if constexpr (detail::returns_route_task<T, P&>)
+            if constexpr (
+                detail::returns_route_task<T, P&> ||
+                detail::returns_route_result<T, P&>)
             {
                 return is_plain;
             }
-            else if constexpr (detail::returns_route_task<
-                T, P&, system::error_code>)
+            else if constexpr (
+                detail::returns_route_task<
+                    T, P&, system::error_code> ||
+                detail::returns_route_result<
+                    T, P&, system::error_code>)
             {
                 return is_error;
             }
@@ -260,8 +280,11 @@ class basic_router : public detail::router_base
             {
                 return is_router;        
             }
-            else if constexpr (detail::returns_route_task<
-                T, P&, std::exception_ptr>)
+            else if constexpr (
+                detail::returns_route_task<
+                    T, P&, std::exception_ptr> ||
+                detail::returns_route_result<
+                    T, P&, std::exception_ptr>)
             {
                 return is_exception;
             }
@@ -271,6 +294,15 @@ class basic_router : public detail::router_base
             }
         }();
 
+    // true if the handler returns route_result directly
+    template<class T>
+    static inline constexpr bool handler_sync =
+        detail::returns_route_result<T, P&> ||
+        detail::returns_route_result<
+            T, P&, system::error_code> ||
+        detail::returns_route_result<
+            T, P&, std::exception_ptr>;
+
     template<class... Ts>
     static inline constexpr bool handler_crvals =
         ((!std::is_lvalue_reference_v<Ts> || 
@@ -288,7 +320,7 @@ class basic_router : public detail::router_base
 
         template<class H_>
         explicit handler_impl(H_ h_)
-            : handler(handler_kind<H>)
+            : handler(handler_kind<H>, handler_sync<H>)
             , h(std::forward<H_>(h_))
         {
         }
@@ -296,7 +328,12 @@ class basic_router : public detail::router_base
         auto invoke(route_params_base& rp) const ->
             route_task override
         {
-            if constexpr (detail::returns_route_task<H, P&>)
+            if constexpr (handler_sync<H>)
+            {
+                return detail::make_route_task(
+                    invoke_sync(rp));
+            }
+            else if constexpr (detail::returns_route_task<H, P&>)
             {
                 return h(static_cast<P&>(rp));
             }
@@ -317,6 +354,30 @@ class basic_router : public detail::router_base
             }
         }
 
+        auto invoke_sync(route_params_base& rp) const ->
+            route_result override
+        {
+            if constexpr (detail::returns_route_result<H, P&>)
+            {
+                return h(static_cast<P&>(rp));
+            }
+            else if constexpr (detail::returns_route_result<
+                H, P&, system::error_code>)
+            {
+                return h(static_cast<P&>(rp), rp.ec_);
+            }
+            else if constexpr (detail::returns_route_result<
+                H, P&, std::exception_ptr>)
+            {
+                return h(static_cast<P&>(rp), rp.ep_);
+            }
+            else
+            {
+                // only called when sync is true
+                std::terminate();
+            }
+        }
+
         detail::router_base*
         get_router() noexcept override
         {
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_CONDITIONAL_HPP
+#define BOOST_HTTP_SERVER_CONDITIONAL_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/request.hpp>
+#include <boost/http/response.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http {
+
+/** The outcome of evaluating the preconditions of a request.
+
+    @see evaluate_preconditions
+*/
+enum class precondition_result
+{
+    /// Perform the request normally.
+    ok,
+
+    /// Respond with 304 Not Modified.
+    not_modified,
+
+    /// Respond with 412 Precondition Failed.
+    precondition_failed
+};
+
+/** Parse an HTTP-date.
+
+    All three formats of RFC 9110 are accepted: the
+    preferred IMF-fixdate, and the obsolete RFC 850
+    and asctime formats. A two-digit RFC 850 year
+    below 70 is taken to be in the 2000s.
+
+    @par Example
+    @code
+    std::uint64_t t;
+    parse_http_date( "Sun, 06 Nov 1994 08:49:37 GMT", t );
+    parse_http_date( "Sunday, 06-Nov-94 08:49:37 GMT", t );
+    parse_http_date( "Sun Nov  6 08:49:37 1994", t );
+    // t == 784111777 in each case
+    @endcode
+
+    @param s The date to parse.
+
+    @param t Set to the seconds since the Unix epoch.
+
+    @return `true` on success, or `false` if `s`
+    is not a valid HTTP-date.
+
+    @see format_http_date
+*/
+BOOST_HTTP_DECL
+bool
+parse_http_date(
+    core::string_view s,
+    std::uint64_t& t) noexcept;
+
+/** Evaluate the preconditions of a request.
+
+    The `If-Match`, `If-Unmodified-Since`,
+    `If-None-Match` and `If-Modified-Since` fields of
+    the request are evaluated against the `ETag` and
+    `Last-Modified` fields of the response, in the
+    order given by RFC 9110 section 13.2.2. Entity
+    tags are compared strongly for `If-Match` and
+    weakly for `If-None-Match`, and dates are compared
+    as points in time regardless of their format.
+    Fields which cannot be parsed are ignored.
+
+    @par Example
+    @code
+    switch( evaluate_preconditions( rp.req, rp.res ) )
+    {
+    case precondition_result::not_modified:
+        rp.status( status::not_modified );
+        co_return co_await rp.send();
+
+    case precondition_result::precondition_failed:
+        rp.status( status::precondition_failed );
+        co_return co_await rp.send();
+
+    case precondition_result::ok:
+        break;
+    }
+    @endcode
+
+    @param req The HTTP request.
+
+    @param res The HTTP response, with the validators
+    of the selected representation set.
+
+    @return The outcome. A failed `If-None-Match` yields
+    @ref precondition_result::not_modified only for GET
+    and HEAD requests.
+*/
+BOOST_HTTP_DECL
+precondition_result
+evaluate_preconditions(
+    request const& req,
+    response const& res) noexcept;
+
+/** Return whether the Range field of a request applies.
+
+    When the request has an `If-Range` field, a range
+    request is only honored if the entity tag in it
+    strongly matches the `ETag` field of the response,
+    or if the date in it equals the `Last-Modified`
+    field of the response. Otherwise the full
+    representation is sent.
+
+    @param req The HTTP request.
+
+    @param res The HTTP response, with the validators
+    of the selected representation set.
+
+    @return `true` if the request has no `If-Range`
+    field or if it matches.
+*/
+BOOST_HTTP_DECL
+bool
+if_range_matches(
+    request const& req,
+    response const& res) noexcept;
+
+} // http
+} // boost
+
+#endif
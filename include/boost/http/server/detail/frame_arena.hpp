@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_FRAME_ARENA_HPP
+#define BOOST_HTTP_SERVER_DETAIL_FRAME_ARENA_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <cstddef>
+#include <memory_resource>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Recycles the coroutine frames of the handlers
+// invoked for one route_params. Freed frames are
+// kept by size in 64 byte classes and handed to
+// the next frame of the same class. Frames larger
+// than the largest class go to the global heap.
+// Not thread safe: a route_params is dispatched
+// by one coroutine at a time.
+class frame_arena
+    : public std::pmr::memory_resource
+{
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t class_count = 64; // up to 4 KiB
+    static constexpr std::size_t max_free = 16;    // per class
+
+    struct free_node
+    {
+        free_node* next;
+    };
+
+    free_node* head_[class_count] = {};
+    unsigned char count_[class_count] = {};
+
+public:
+    frame_arena() = default;
+
+    // A copy starts with no free frames
+    frame_arena(frame_arena const&) noexcept
+        : frame_arena()
+    {
+    }
+
+    frame_arena&
+    operator=(frame_arena const&) noexcept
+    {
+        return *this;
+    }
+
+    BOOST_HTTP_DECL
+    ~frame_arena();
+
+    // Make this the allocator of coroutine frames
+    // created on this thread until destroyed
+    class scope
+    {
+        std::pmr::memory_resource* prev_;
+
+    public:
+        BOOST_HTTP_DECL
+        explicit
+        scope(frame_arena& a) noexcept;
+
+        BOOST_HTTP_DECL
+        ~scope();
+
+        scope(scope const&) = delete;
+        scope& operator=(scope const&) = delete;
+    };
+
+private:
+    BOOST_HTTP_DECL
+    void*
+    do_allocate(
+        std::size_t n,
+        std::size_t align) override;
+
+    BOOST_HTTP_DECL
+    void
+    do_deallocate(
+        void* p,
+        std::size_t n,
+        std::size_t align) noexcept override;
+
+    bool
+    do_is_equal(
+        std::pmr::memory_resource const& other)
+            const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
@@ -55,11 +55,18 @@ protected:
         handler
     {
         char const kind;
-        explicit handler(char kind_) noexcept : kind(kind_) {}
+        bool const sync;    // call invoke_sync instead of invoke
+        explicit handler(char kind_, bool sync_ = false) noexcept
+            : kind(kind_), sync(sync_) {}
         virtual ~handler() = default;
         virtual auto invoke(route_params_base&) const ->
             route_task = 0;
 
+        // Used by flat_router when sync is true. Runs the
+        // handler to completion without a coroutine frame.
+        virtual auto invoke_sync(route_params_base&) const ->
+            route_result = 0;
+
         // Returns the nested router if this handler wraps one, nullptr otherwise.
         // Used by flat_router::flatten() to recurse into nested routers.
         virtual router_base* get_router() noexcept { return nullptr; }
@@ -104,6 +111,20 @@ template<class H, class... Args>
 concept returns_route_task = std::same_as<
     std::invoke_result_t<H, Args...>, route_task>;
 
+template<class H, class... Args>
+concept returns_route_result =
+    ! returns_route_task<H, Args...> &&
+    std::convertible_to<
+        std::invoke_result_t<H, Args...>, route_result>;
+
+// Wraps the result of a synchronous handler
+inline
+route_task
+make_route_task(route_result rv)
+{
+    co_return rv;
+}
+
 } // detail
 } // http
 } // boost
@@ -36,7 +36,7 @@ struct etag_options
     @code
     std::string content = "Hello, World!";
     std::string tag = etag( content );
-    // tag == "\"d-3/1gIbsr1bCvZ2KQgJ7DpTGR3YH\""
+    // tag == "\"d-c49aacf8080fe47f\""
     @endcode
 
     @param body The content to hash.
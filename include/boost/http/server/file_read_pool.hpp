@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_FILE_READ_POOL_HPP
+#define BOOST_HTTP_SERVER_FILE_READ_POOL_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/router.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http {
+
+class pooled_file_reader;
+
+/** A bounded pool of threads for blocking file reads.
+
+    The threads of the pool do nothing but read
+    files for @ref pooled_file_reader objects, so
+    a read from slow storage blocks one of them
+    instead of the thread of a connection. Threads
+    are started as reads are submitted, up to the
+    limit given on construction. Reads wait in
+    order of submission when all threads are busy.
+
+    @par Thread Safety
+    Distinct readers may use the same pool from
+    any number of threads.
+
+    @par Example
+    @code
+    file_read_pool pool( 4 );
+
+    serve_static_options opts;
+    opts.read_pool = &pool;
+    r.use( serve_static( "/var/www", opts ) );
+    @endcode
+
+    @see pooled_file_reader, route_params::file_io
+*/
+class BOOST_HTTP_DECL file_read_pool
+{
+    struct impl;
+    impl* impl_;
+
+    friend class pooled_file_reader;
+
+    void submit(pooled_file_reader& r);
+
+public:
+    /** Destructor.
+
+        Waits for the reads in progress, then stops
+        the threads. No reader may have a read which
+        was not yet awaited.
+    */
+    ~file_read_pool();
+
+    /** Constructor.
+
+        No thread is started until the first read.
+
+        @param max_threads The most threads the pool
+        runs at once. Zero is treated as one.
+    */
+    explicit
+    file_read_pool(std::size_t max_threads = 4);
+
+    file_read_pool(file_read_pool const&) = delete;
+    file_read_pool& operator=(file_read_pool const&) = delete;
+
+    /** Return the most threads the pool runs at once.
+    */
+    std::size_t
+    max_threads() const noexcept;
+};
+
+//------------------------------------------------
+
+/** A file reader which reads on a @ref file_read_pool.
+
+    Each read is handed to a thread of the pool, and
+    the coroutine awaiting it is resumed through the
+    executor it was running on, so it continues on
+    the thread of its connection.
+
+    A reader serves one request at a time. A server
+    may keep one per connection and point
+    @ref route_params::file_io at it, or let
+    @ref serve_static make one for each request from
+    @ref serve_static_options::read_pool.
+
+    @see file_read_pool, file_reader
+*/
+class BOOST_HTTP_DECL pooled_file_reader
+    : public file_reader
+{
+    enum class state : unsigned char
+    {
+        idle,
+        pending,
+        done,
+        waiting
+    };
+
+    struct wait_op;
+
+    friend class file_read_pool;
+
+    file_read_pool& pool_;
+    pooled_file_reader* next_ = nullptr;
+    file* f_ = nullptr;
+    std::uint64_t offset_ = 0;
+    capy::mutable_buffer b_;
+    system::error_code ec_;
+    std::size_t n_ = 0;
+    capy::coro h_;
+    capy::executor_ref ex_;
+    std::atomic<state> state_{ state::idle };
+
+    void run() noexcept;
+
+public:
+    /** Destructor.
+
+        If a read was started and not awaited, this
+        blocks until the read completes.
+    */
+    ~pooled_file_reader();
+
+    /** Constructor.
+
+        @param pool The pool which performs the reads.
+        It must outlive the reader.
+    */
+    explicit
+    pooled_file_reader(file_read_pool& pool) noexcept;
+
+    pooled_file_reader(pooled_file_reader const&) = delete;
+    pooled_file_reader& operator=(pooled_file_reader const&) = delete;
+
+    /** Start reading from a file at an offset.
+
+        The read is queued on the pool and this
+        returns at once.
+
+        @param f The open file.
+
+        @param offset The offset of the first byte to read.
+
+        @param b The buffer to read into.
+    */
+    void
+    start_read(
+        file& f,
+        std::uint64_t offset,
+        capy::mutable_buffer b) override;
+
+    /** Wait for the read started last.
+
+        The awaiting coroutine is resumed through its
+        own executor once a thread of the pool has
+        finished the read.
+
+        @return An awaitable yielding `(error_code, std::size_t)`,
+        the number of bytes read, which is zero at the end
+        of the file or when no read was started.
+    */
+    capy::io_task<std::size_t>
+    wait_read() override;
+};
+
+} // http
+} // boost
+
+#endif
@@ -16,10 +16,13 @@
 #include <boost/url/url_view.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/assert.hpp>
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace boost {
 namespace http {
@@ -29,6 +32,62 @@ namespace http {
 #pragma warning(disable: 4251) // shared_ptr needs dll-interface
 #endif
 
+/** Counters for one handler of a flat_router.
+
+    @see
+        @ref flat_router::enable_stats,
+        @ref flat_router::stats.
+*/
+struct route_stats
+{
+    /** The number of latency buckets.
+    */
+    static constexpr std::size_t buckets = 32;
+
+    /** The path pattern, including the mount points.
+    */
+    std::string pattern;
+
+    /** The method matched, or empty for any method.
+    */
+    std::string method;
+
+    /** The number of times the handler was invoked.
+    */
+    std::uint64_t calls = 0;
+
+    /** The number of invocations by outcome.
+
+        Elements are indexed by @ref route_what.
+        The last element counts handlers which
+        exited with an exception.
+    */
+    std::uint64_t outcomes[6] = {};
+
+    /** Histogram of the time spent in the handler.
+
+        Bucket `k` counts invocations which took
+        from `2^k` up to `2^(k+1)` nanoseconds. The
+        first bucket also counts shorter times and
+        the last bucket also counts longer ones.
+    */
+    std::uint64_t latency[buckets] = {};
+
+    /** Add the counters in another object to this one.
+
+        @param other The counters to add.
+    */
+    void
+    merge(route_stats const& other) noexcept
+    {
+        calls += other.calls;
+        for(std::size_t i = 0; i < 6; ++i)
+            outcomes[i] += other.outcomes[i];
+        for(std::size_t i = 0; i < buckets; ++i)
+            latency[i] += other.latency[i];
+    }
+};
+
 /** A flattened router optimized for dispatch performance.
 
     `flat_router` is constructed from a @ref router by flattening
@@ -46,10 +105,132 @@ class BOOST_HTTP_DECL
     struct impl;
     std::shared_ptr<impl> impl_;
 
+    friend class atomic_flat_router;
+
+    explicit
+    flat_router(
+        std::shared_ptr<impl> sp) noexcept
+        : impl_(std::move(sp))
+    {
+    }
+
+    // As dispatch, but the task shares ownership
+    // of the routes until it completes.
+    route_task
+    dispatch_shared(
+        http::method verb,
+        urls::url_view const& url,
+        route_params_base& p) const;
+
+    route_task
+    dispatch_shared(
+        std::string_view verb,
+        urls::url_view const& url,
+        route_params_base& p) const;
+
 public:
     flat_router(
         detail::router_base&&);
 
+    /** Constructor.
+
+        The router is flattened as with the single
+        argument constructor, and a cache of up to
+        `cache_size` resolved routes is enabled.
+
+        Each cached route maps a method and decoded
+        path to the sequence of handlers it reaches,
+        so repeated requests for the same path skip
+        the matchers entirely. Lookups and insertions
+        are lock-free. A path is cached the second
+        time it is requested, so paths requested only
+        once do not take slots. Entries are never
+        evicted; a path which finds no free slot is
+        dispatched normally.
+        Requests with a custom method are not cached.
+
+        The cache belongs to the flattened routes and
+        is shared by copies of this object. Rebuilding
+        the router produces a new, empty cache.
+
+        @param cache_size The number of cache slots.
+        Zero disables the cache.
+    */
+    flat_router(
+        detail::router_base&&,
+        std::size_t cache_size);
+
+    /** Enable per-handler instrumentation.
+
+        Once enabled, each invocation of a handler
+        updates its call count, its outcome counts
+        and a histogram of the time the handler
+        took, measured from invocation until it
+        returns or its task completes. Counters are
+        kept per thread, in cache-line aligned sets,
+        and updated without locks. When not enabled,
+        dispatch only tests a null pointer.
+
+        Instrumentation is shared by copies of this
+        object. This function must not be called
+        concurrently with any other member function.
+
+        @param shards The number of counter sets.
+        Threads are spread across the sets. Zero
+        uses `std::thread::hardware_concurrency()`.
+    */
+    void
+    enable_stats(std::size_t shards = 0);
+
+    /** Return a snapshot of the counters.
+
+        The counters of all threads are merged.
+        There is one element for each handler, in
+        dispatch order. The result is empty if
+        instrumentation is not enabled.
+
+        This function may be called concurrently
+        with dispatch.
+    */
+    std::vector<route_stats>
+    stats() const;
+
+    /** Return the methods of the routes matching a path.
+
+        This is used to build the Allow field of a
+        405 (Method Not Allowed) response when dispatch
+        completes with @ref route_next. Each route
+        records at construction the methods of its
+        handlers, so only the patterns of routes are
+        tested, once each. Middleware is not considered.
+
+        @par Example
+        @code
+        auto rv = co_await fr.dispatch( verb, url, p );
+        if( rv.what() == route_what::next )
+        {
+            auto allow = fr.allowed_methods( p );
+            if( ! allow.empty() )
+            {
+                p.status( status::method_not_allowed );
+                p.res.set( field::allow, allow );
+            }
+        }
+        @endcode
+
+        @par Preconditions
+        `p` was last passed to a dispatch function
+        of this object.
+
+        @return A comma separated list of methods,
+        or an empty string if no route matches the
+        path.
+
+        @param p The params used for the dispatch.
+    */
+    std::string
+    allowed_methods(route_params_base& p) const;
+
     /** Dispatch a request using a known HTTP method.
 
         @param verb The HTTP method to match. Must not be
@@ -51,7 +51,9 @@ namespace http {
     @return `true` if the response is fresh (304 should be sent),
     `false` if the full response should be sent.
 
-    @see http::field::if_none_match, http::field::if_modified_since
+    @see evaluate_preconditions,
+        http::field::if_none_match,
+        http::field::if_modified_since
 */
 BOOST_HTTP_DECL
 bool
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_MIME_MAP_HPP
+#define BOOST_HTTP_SERVER_MIME_MAP_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/mime_db.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace http {
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4251) // shared_ptr needs dll-interface
+#endif
+
+/** An immutable map from file extensions to MIME types.
+
+    Each extension maps to a @ref mime_type_entry holding
+    the type, its default charset and whether it is
+    compressible. A default-constructed map holds the
+    built-in database used by @ref mime_types. Larger
+    databases are loaded at startup from a `mime.types`
+    file, as shipped with Apache and most Unix systems,
+    or from a JSON file in the format of the `mime-db`
+    package. Loaded entries are added to the built-in
+    ones, replacing those with the same extension.
+
+    Extensions are stored lowercased in a hash table
+    whose hash functions are chosen when the map is
+    built so that no two extensions collide. A lookup
+    lowercases the extension into a local buffer and
+    reads exactly one slot of the table.
+
+    The map is never modified after construction.
+    Copies share the same table, and may be used
+    concurrently from any number of threads.
+
+    @par Example
+    @code
+    mime_map const types = mime_map::load( "/etc/mime.types" );
+
+    auto const* e = types.find( "report.xlsx" );
+    if( e )
+        res.set( field::content_type, e->type );
+    @endcode
+
+    @see mime_types, mime_db
+*/
+class BOOST_HTTP_DECL
+    mime_map
+{
+    struct impl;
+    std::shared_ptr<impl const> impl_;
+
+    explicit
+    mime_map(
+        std::shared_ptr<impl const> sp) noexcept
+        : impl_(std::move(sp))
+    {
+    }
+
+public:
+    /** Constructor.
+
+        The map holds the built-in database.
+    */
+    mime_map();
+
+    /** Return a map built from a `mime.types` file.
+
+        Each line of the file holds a MIME type followed
+        by its extensions, separated by whitespace. Text
+        from `#` to the end of a line is ignored. The
+        charset and compressibility of types in the
+        built-in @ref mime_db are used; other `text/`
+        types get the UTF-8 charset, and types ending in
+        `json` or `xml` are considered compressible.
+
+        @param text The contents of the file.
+    */
+    static
+    mime_map
+    from_mime_types(core::string_view text);
+
+    /** Return a map built from a JSON database.
+
+        The text is a JSON object in the format of the
+        `mime-db` package, whose keys are MIME types and
+        whose values are objects with the optional
+        members `extensions`, `charset` and
+        `compressible`.
+
+        @param text The contents of the file.
+
+        @throws std::invalid_argument The text is not
+        a JSON object.
+    */
+    static
+    mime_map
+    from_json(core::string_view text);
+
+    /** Return a map built from a file.
+
+        The file is read as a JSON database if its first
+        non-whitespace character is `{`, and as a
+        `mime.types` file otherwise.
+
+        @param path The path of the file.
+
+        @throws system_error The file could not be read.
+
+        @throws std::invalid_argument The file is
+        malformed JSON.
+    */
+    static
+    mime_map
+    load(char const* path);
+
+    /** Look up a file path or extension.
+
+        The extension is the text after the last dot
+        in the last segment of `path_or_ext`, or all of
+        it when there is no dot. The lookup is
+        case-insensitive.
+
+        @param path_or_ext A file path (e.g. "index.html")
+        or extension (e.g. ".html" or "html").
+
+        @return The entry, or `nullptr` if the extension
+        is not in the map.
+    */
+    mime_type_entry const*
+    find(core::string_view path_or_ext) const noexcept;
+
+    /** Return the Content-Type for a file path or extension.
+
+        @param path_or_ext A file path or extension.
+
+        @return The MIME type followed by its charset
+        parameter, if any, or an empty string if the
+        extension is not in the map.
+    */
+    std::string
+    content_type(core::string_view path_or_ext) const;
+
+    /** Return the number of extensions in the map.
+    */
+    std::size_t
+    size() const noexcept;
+};
+
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // http
+} // boost
+
+#endif
@@ -38,7 +38,7 @@ namespace http {
     // ct == "application/json; charset=utf-8"
     @endcode
 
-    @see mime_db
+    @see mime_db, mime_map
 */
 namespace mime_types {
 
@@ -12,6 +12,7 @@
 
 #include <boost/http/detail/config.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -92,6 +93,32 @@ BOOST_HTTP_DECL
 range_result
 parse_range(std::int64_t size, core::string_view header);
 
+/** Parse an HTTP Range header, limiting the number of ranges.
+
+    This behaves as the two argument overload, except
+    that parsing stops as soon as the field is seen to
+    list more than `max_ranges` ranges. The result is
+    then @ref range_result_type::malformed with no
+    ranges, so the field is ignored. A field listing
+    many ranges is rejected without storing them.
+
+    @param size The size of the resource in bytes.
+
+    @param header The Range header value.
+
+    @param max_ranges The largest number of ranges
+    accepted, counted as they appear in the field.
+
+    @return A range_result containing the parsed ranges and
+    result type.
+*/
+BOOST_HTTP_DECL
+range_result
+parse_range(
+    std::int64_t size,
+    core::string_view header,
+    std::size_t max_ranges);
+
 } // http
 } // boost
 
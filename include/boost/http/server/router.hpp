@@ -20,16 +20,134 @@
 #include <boost/capy/io/any_buffer_source.hpp>
 #include <boost/capy/io/any_buffer_sink.hpp>
 #include <boost/http/datastore.hpp>
+#include <boost/http/file.hpp>
 #include <boost/http/request.hpp>
 #include <boost/http/response.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/system/error_code.hpp>
+#include <cstdint>
 #include <memory>
 #include <span>
 
 namespace boost {
 namespace http {
 
+/** A response body sink which sends file contents directly.
+
+    A server whose connection writes to a socket
+    descriptor may set @ref route_params::res_file to
+    an object of this type. Handlers which serve files,
+    such as @ref serve_static, then hand the file to it
+    instead of reading the contents into buffers and
+    writing them to @ref route_params::res_body.
+
+    An implementation typically sends the serialized
+    header, then calls `sendfile` on the socket in
+    large slices, waiting for the socket to become
+    writable between calls. It must only be installed
+    when the bytes of the body reach the socket
+    unchanged, for example not over TLS.
+
+    @see route_params::res_file
+*/
+class file_body_sink
+{
+public:
+    /** Destructor.
+    */
+    virtual ~file_body_sink() = default;
+
+    /** Send a range of a file as the complete body.
+
+        The response header is sent first if it has
+        not been sent already, and the body ends after
+        the range. The position of `f` is unspecified
+        when the operation completes.
+
+        @param f The open file.
+
+        @param offset The offset of the first byte to send.
+
+        @param n The number of bytes to send.
+
+        @return An awaitable yielding `(error_code)`.
+    */
+    virtual
+    capy::io_task<>
+    send_file(
+        file& f,
+        std::uint64_t offset,
+        std::uint64_t n) = 0;
+};
+
+/** A reader of files which does not block the caller.
+
+    Reading a file which is not in the page cache
+    blocks the calling thread, and with it every other
+    connection served by the same thread. A server may
+    set @ref route_params::file_io to an object of this
+    type. Handlers which serve files, such as
+    @ref serve_static, then read through it instead of
+    calling @ref file::read.
+
+    An implementation typically performs the read on
+    a bounded pool of threads reserved for blocking
+    I/O, or submits it to `io_uring` where available,
+    and resumes the waiting coroutine on the executor
+    of the connection.
+
+    A read is started and awaited separately, so the
+    caller can send the previous buffer while the next
+    one is being filled.
+
+    @par Example
+    @code
+    io.start_read( f, offset, capy::make_buffer( next ) );
+    co_await p.res_body.write( capy::make_buffer( prev ) );
+    auto [ec, n] = co_await io.wait_read();
+    @endcode
+
+    @see route_params::file_io
+*/
+class file_reader
+{
+public:
+    /** Destructor.
+    */
+    virtual ~file_reader() = default;
+
+    /** Start reading from a file at an offset.
+
+        This function returns without waiting for the
+        read. At most one read may be outstanding, and
+        the file and the buffer must remain valid until
+        @ref wait_read completes. The position of `f`
+        is unspecified afterwards.
+
+        @param f The open file.
+
+        @param offset The offset of the first byte to read.
+
+        @param b The buffer to read into.
+    */
+    virtual
+    void
+    start_read(
+        file& f,
+        std::uint64_t offset,
+        capy::mutable_buffer b) = 0;
+
+    /** Wait for the read started last.
+
+        @return An awaitable yielding `(error_code, std::size_t)`,
+        the number of bytes read, which is zero at the end
+        of the file.
+    */
+    virtual
+    capy::io_task<std::size_t>
+    wait_read() = 0;
+};
+
 /** Parameters object for HTTP route handlers.
 
     This structure holds all the context needed for a route
@@ -55,6 +173,8 @@ struct BOOST_HTTP_SYMBOL_VISIBLE
     http::response res;
     capy::any_buffer_source req_body;
     capy::any_buffer_sink res_body;
+    file_body_sink* res_file = nullptr; // optional zero-copy body path
+    file_reader* file_io = nullptr; // optional non-blocking file reads
     http::datastore route_data; // arbitrary data
     http::datastore session_data;
 
@@ -13,6 +13,7 @@
 #include <boost/http/detail/config.hpp>
 #include <boost/http/method.hpp>
 #include <boost/http/detail/except.hpp>
+#include <boost/http/server/detail/frame_arena.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/capy/io_result.hpp>
 #include <boost/capy/task.hpp>
@@ -309,6 +310,15 @@ auto route_error(E e) noexcept ->
     }
     @endcode
 
+    When a router invokes a handler, the frame of the
+    handler's coroutine, and of coroutines it creates,
+    is allocated through capy's frame allocator from
+    an arena owned by the @ref route_params_base. A
+    freed frame is reused by the next handler, so a
+    connection's handlers stop allocating from the
+    global heap after the first requests. Such frames
+    must not outlive the route parameters.
+
     @see route_result, route_params
 */
 using route_task = capy::task<route_result>;
@@ -320,12 +330,35 @@ class router_base;
 } // detail
 template<class> class basic_router;
 
+/** A parameter captured from the request path
+
+    @see route_params_base::param
+*/
+struct route_param
+{
+    /** The name of the parameter in the route pattern
+    */
+    core::string_view name;
+
+    /** The matched text, after percent-decoding
+    */
+    core::string_view value;
+};
+
 struct route_params_base_privates
 {
+    /** The maximum number of captured parameters
+
+        Parameters in excess of this number still
+        participate in matching, but are not captured.
+    */
+    static constexpr std::size_t max_params = 16;
+
     struct match_result;
 
     std::string verb_str_;
     std::string decoded_path_;
+    std::string lowered_path_;  // decoded_path_ in lowercase
     system::error_code ec_;
     std::exception_ptr ep_;
     std::size_t pos_ = 0;
@@ -336,6 +369,9 @@ struct route_params_base_privates
     bool case_sensitive = false;
     bool strict = false;
     char kind_ = 0;  // dispatch mode, initialized by flat_router::dispatch()
+    std::size_t nparams_ = 0;
+    route_param params_[max_params];
+    detail::frame_arena frames_;    // handler coroutine frames
 };
 
 /** Base class for request objects
@@ -373,6 +409,58 @@ public:
     */
     core::string_view path;
 
+    /** Return the parameters captured from the path
+
+        Each parameter named in the patterns of the
+        matched route and its mount points, such as
+        `:id` in `"/users/:id"`, is captured in order.
+        The strings point into storage owned by this
+        object and remain valid until the next dispatch.
+        Capture does not allocate.
+
+        @par Example
+        @code
+        router.add( method::get, "/users/:id(\\d+)",
+            []( route_params& p )
+            {
+                auto id = p.param( "id" );
+                ...
+            } );
+        @endcode
+
+        @return A pointer to the first of
+        @ref param_count parameters.
+    */
+    route_param const*
+    params() const noexcept
+    {
+        return params_;
+    }
+
+    /** Return the number of parameters captured from the path
+    */
+    std::size_t
+    param_count() const noexcept
+    {
+        return nparams_;
+    }
+
+    /** Return the value of a captured parameter
+
+        @return The value of the first parameter named
+        `name`, or an empty string if there is none.
+
+        @param name The name of the parameter.
+    */
+    core::string_view
+    param(core::string_view name) const noexcept
+    {
+        for(std::size_t i = 0; i < nparams_; ++i)
+            if(params_[i].name == name)
+                return params_[i].value;
+        return {};
+    }
+
    struct match_result;
 
 private:
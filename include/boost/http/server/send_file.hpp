@@ -12,9 +12,12 @@
 
 #include <boost/http/detail/config.hpp>
 #include <boost/http/server/router.hpp>
+#include <boost/http/server/range_parser.hpp>
+#include <boost/http/file.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace boost {
 namespace http {
@@ -34,6 +37,16 @@ struct send_file_options
 
     /// Content-Type to use (empty = auto-detect from extension).
     std::string content_type;
+
+    /** Maximum number of ranges in a Range field.
+
+        If the field lists more ranges, it is ignored
+        and the full content is sent. Parsing stops at
+        the first range past the limit. Overlapping and
+        adjacent ranges are then merged, so a response
+        has at most this many parts.
+    */
+    std::size_t max_ranges = 16;
 };
 
 /** Result of send_file_init.
@@ -49,7 +62,11 @@ enum class send_file_result
     /// Response is fresh (304 Not Modified should be sent).
     not_modified,
 
-    /// Error opening or reading file.
+    /** The response status is set and has no body.
+
+        This is the case for an unsatisfiable range
+        or a failed precondition.
+    */
     error
 };
 
@@ -83,6 +100,30 @@ struct send_file_info
 
     /// True if this is a range response.
     bool is_range = false;
+
+    /** The ranges of a multipart/byteranges response.
+
+        This is empty unless the response has more than
+        one range, in which case `range_start` and
+        `range_end` are unused. The body is made of each
+        range preceded by @ref send_file_delimiter for
+        its index, and ends with the delimiter for the
+        index `ranges.size()`.
+    */
+    std::vector<byte_range> ranges;
+
+    /// The multipart boundary, when `ranges` is not empty.
+    std::string boundary;
+
+    /** The open file, positioned at its start.
+
+        @ref send_file_init opens the file once and
+        takes its size and modification time from the
+        open descriptor, which is then used to send the
+        body. The file is open when `result` is
+        @ref send_file_result::ok.
+    */
+    http::file file;
 };
 
 /** Initialize headers for sending a file.
@@ -90,14 +131,19 @@ struct send_file_info
     This function prepares the response headers for serving
     a static file. It performs the following tasks:
 
-    @li Opens and validates the file
+    @li Opens the file, and reads its type, size and
+        modification time from the open descriptor
     @li Sets Content-Type based on file extension
     @li Generates ETag and Last-Modified headers
-    @li Checks for conditional requests (freshness)
-    @li Parses Range headers for partial content
+    @li Evaluates conditional request fields,
+        including `If-Match` and `If-Range`
+    @li Parses Range headers for partial content,
+        producing a multipart/byteranges response
+        when more than one range is requested
 
-    After calling this function, use the returned info to
-    stream the file content using `res_body.write()`.
+    After calling this function, send the body with
+    @ref send_file_body, or read it from `info.file`
+    and write it using `res_body.write()`.
 
     @par Example
     @code
@@ -115,7 +161,10 @@ struct send_file_info
         if( info.result != send_file_result::ok )
             co_return route_next;
 
-        // Stream file content...
+        auto [ec] = co_await send_file_body( rp, info, rp.file_io );
+        if( ec )
+            co_return route_error( ec );
+        co_return route_done;
     }
     @endcode
 
@@ -135,6 +184,76 @@ send_file_init(
     core::string_view path,
     send_file_options const& opts = {});
 
+/** Return a delimiter of a multipart/byteranges body.
+
+    For `i` less than `info.ranges.size()`, this
+    returns the boundary and the header of the part
+    holding range `i`. For `i == info.ranges.size()`,
+    it returns the final boundary ending the body.
+
+    @par Example
+    @code
+    for( std::size_t i = 0; i < info.ranges.size(); ++i )
+    {
+        co_await write( send_file_delimiter( info, i ) );
+        // write bytes info.ranges[i].start through
+        // info.ranges[i].end of the file
+    }
+    co_await write( send_file_delimiter( info, info.ranges.size() ) );
+    @endcode
+
+    @param info The information from @ref send_file_init.
+
+    @param i The index of the part.
+*/
+BOOST_HTTP_DECL
+std::string
+send_file_delimiter(
+    send_file_info const& info,
+    std::size_t i);
+
+/** Send the body of a file prepared by @ref send_file_init.
+
+    The content of `info.file` is written to
+    `rp.res_body`: the requested range, or every part
+    of a multipart/byteranges body with its delimiters.
+    The body is then ended with `write_eof`.
+
+    When `io` is not null the file is read through it,
+    so the calling thread does not block on the disk,
+    and the next buffer is read while the current one
+    is written. Otherwise the file is read on the
+    calling thread. The position of `info.file` is
+    unspecified when the operation completes.
+
+    @par Example
+    @code
+    file_read_pool pool;
+    pooled_file_reader reader( pool );
+    auto [ec] = co_await send_file_body( rp, info, &reader );
+    @endcode
+
+    @return An awaitable yielding `(error_code)`. A
+    file which ends before the size recorded in `info`
+    yields @ref error::incomplete.
+
+    @param rp The route parameters.
+
+    @param info The information from @ref send_file_init,
+    whose result is @ref send_file_result::ok.
+
+    @param io The reader to read the file through,
+    or null to read it on the calling thread.
+
+    @see file_reader, pooled_file_reader
+*/
+BOOST_HTTP_DECL
+capy::io_task<>
+send_file_body(
+    route_params& rp,
+    send_file_info& info,
+    file_reader* io = nullptr);
+
 /** Format Last-Modified time from Unix timestamp.
 
     @param mtime Unix timestamp (seconds since epoch).
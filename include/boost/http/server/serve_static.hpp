@@ -11,11 +11,14 @@
 #define BOOST_HTTP_SERVER_SERVE_STATIC_HPP
 
 #include <boost/http/detail/config.hpp>
+#include <boost/http/server/mime_map.hpp>
 #include <boost/http/server/router.hpp>
 
 namespace boost {
 namespace http {
 
+class file_read_pool;
+
 /** Policy for handling dotfiles in static file serving.
 */
 enum class dotfiles_policy
@@ -40,6 +43,61 @@ struct serve_static_options
     /// Maximum cache age in seconds.
     std::uint32_t max_age = 0;
 
+    /** Maximum number of request paths whose file lookup is cached.
+
+        When nonzero, the file a request path resolves
+        to, its size, modification time, content type,
+        ETag and Last-Modified values, and an open
+        descriptor are kept in memory, so repeated
+        requests for a file make no metadata system
+        calls. Paths which name no file are not cached.
+        The least recently used path is evicted when
+        the cache is full. Zero disables the cache.
+
+        Each cached path holds one open descriptor,
+        and one more for each precompressed sibling
+        when @ref precompressed is set, so up to three
+        times this many descriptors may stay open.
+    */
+    std::size_t cache_size = 0;
+
+    /** Seconds for which a cached file lookup is used.
+
+        A file changed on disk may be served with its
+        previous metadata and contents for up to this
+        long.
+    */
+    std::uint32_t cache_ttl = 2;
+
+    /** Maximum bytes of file contents kept in memory.
+
+        When nonzero, the contents of files no larger
+        than @ref memory_cache_max_file are kept in a
+        least recently used cache of this total size,
+        and requests for them are answered from memory
+        with a single write. Precompressed siblings are
+        cached separately. A body is discarded when its
+        file is seen with a different size or
+        modification time. Zero disables the cache.
+    */
+    std::size_t memory_cache_size = 0;
+
+    /// Largest file whose contents are kept in memory.
+    std::uint64_t memory_cache_max_file = 65536;
+
+    /** Pool of threads for reading file contents.
+
+        When set, and the route parameters of a request
+        have no @ref route_params::file_io, the file is
+        read on this pool through a
+        @ref pooled_file_reader made for the request,
+        so slow storage does not stall the thread of
+        the connection. The pool must outlive the
+        middleware. When null, files are read on the
+        calling thread.
+    */
+    file_read_pool* read_pool = nullptr;
+
     /// Enable accepting range requests.
     bool accept_ranges = true;
 
@@ -58,8 +116,31 @@ struct serve_static_options
     /// Enable the "Last-Modified" header.
     bool last_modified = true;
 
+    /** Serve precompressed siblings of files.
+
+        When enabled, a request for `file` may be
+        answered with `file.br` or `file.gz` if it
+        exists and the Accept-Encoding field of the
+        request allows it, preferring the coding with
+        the higher quality value, and Brotli on a tie.
+        The response carries the Content-Encoding of
+        the sibling, the Content-Type of the original
+        file, and the size and ETag of the sibling.
+        Responses for files with siblings also carry
+        `Vary: Accept-Encoding`.
+    */
+    bool precompressed = false;
+
     /// Enable redirection for directories missing a trailing slash.
     bool redirect = true;
+
+    /** The MIME types used for the Content-Type field.
+
+        This defaults to the built-in database. A map
+        loaded with @ref mime_map::load recognizes more
+        extensions.
+    */
+    mime_map mime;
 };
 
 /** Coroutine-based static file server middleware.
@@ -94,6 +175,16 @@ public:
 
     /** Construct with document root and options.
 
+        A request path with a `..` segment is refused.
+        On POSIX systems the root directory is opened
+        here and files are opened relative to it, so a
+        symbolic link cannot lead outside the root
+        either. On Linux 5.6 and later a link which stays
+        below the root is followed; on other POSIX systems
+        no link below the root is followed. Elsewhere, or if the
+        root cannot be opened here, links below the root
+        are followed wherever they point.
+
         @param root The document root path.
 
         @param opts Configuration options.
@@ -0,0 +1,457 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_STATIC_ROUTES_HPP
+#define BOOST_HTTP_SERVER_STATIC_ROUTES_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/router_types.hpp>
+#include <boost/http/server/detail/router_base.hpp>
+#include <boost/http/method.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace http {
+
+namespace detail {
+
+// Returns true if the pattern is a route-pattern
+// made only of literal segments, see route_rule.hpp.
+// Characters which the route grammar gives meaning
+// anywhere in a segment are rejected wherever they
+// appear, so a pattern is never read as a literal
+// when the router would read it otherwise.
+constexpr
+bool
+is_literal_route(
+    char const* s,
+    std::size_t n) noexcept
+{
+    if(n == 0 || s[0] != '/')
+        return false;
+    for(std::size_t i = 1; i < n; ++i)
+    {
+        char const c = s[i];
+        if(c == '/')
+        {
+            // empty segment
+            if(s[i - 1] == '/')
+                return false;
+            continue;
+        }
+        switch(c)
+        {
+        // param-prefix, constraint and modifier
+        case ':':
+        case '*':
+        case '{':
+        case '}':
+        case '(':
+        case ')':
+        // patterns are decoded when mounted,
+        // so the table requires decoded text
+        case '%':
+            return false;
+        default:
+            break;
+        }
+        if(c < 0x21 || c > 0x7E)
+            return false;
+    }
+    return true;
+}
+
+// The distinct lengths compared by a set of
+// routes, in increasing order
+template<std::size_t M>
+struct route_lengths
+{
+    std::size_t v[M == 0 ? 1 : M] = {};
+    std::size_t count = 0;
+};
+
+template<bool Strict, class... Routes>
+constexpr
+route_lengths<sizeof...(Routes)>
+make_route_lengths() noexcept
+{
+    route_lengths<sizeof...(Routes)> r;
+    std::size_t const all[] = { 0, (Strict ?
+        Routes::strict_size : Routes::loose_size)... };
+    for(std::size_t i = 1; i < sizeof(all) / sizeof(all[0]); ++i)
+    {
+        std::size_t j = 0;
+        while(j < r.count && r.v[j] < all[i])
+            ++j;
+        if(j < r.count && r.v[j] == all[i])
+            continue;
+        for(std::size_t k = r.count; k > j; --k)
+            r.v[k] = r.v[k - 1];
+        r.v[j] = all[i];
+        ++r.count;
+    }
+    return r;
+}
+
+// Not constexpr: a call during constant
+// evaluation makes the program ill-formed.
+inline
+void
+invalid_static_route_pattern() noexcept
+{
+}
+
+} // detail
+
+/** A route pattern used as a template argument
+
+    Objects of this type are constructed at compile
+    time from a string literal, which must be a
+    route pattern made only of literal segments,
+    such as `"/health"` or `"/api/v1/status"`.
+    Parameters, percent-escapes, empty segments and
+    the characters `:*{}()` are rejected at compile
+    time.
+
+    @see
+        @ref static_route,
+        @ref static_routes.
+*/
+template<std::size_t N>
+struct route_literal
+{
+    /** The pattern
+    */
+    char s[N] = {};
+
+    /** The pattern in lowercase
+    */
+    char lower[N] = {};
+
+    /** Constructor.
+
+        @param v The pattern.
+    */
+    consteval
+    route_literal(char const(&v)[N])
+    {
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            s[i] = v[i];
+            lower[i] = (v[i] >= 'A' && v[i] <= 'Z') ?
+                static_cast<char>(v[i] + ('a' - 'A')) : v[i];
+        }
+        if(! detail::is_literal_route(s, N - 1))
+            detail::invalid_static_route_pattern();
+    }
+
+    /** Return the length of the pattern
+    */
+    static constexpr
+    std::size_t
+    size() noexcept
+    {
+        return N - 1;
+    }
+
+    /** Return the length of the pattern without a trailing slash
+
+        This is the length compared when matching
+        is not strict.
+    */
+    constexpr
+    std::size_t
+    loose_size() const noexcept
+    {
+        if(N - 1 > 1 && s[N - 2] == '/')
+            return N - 2;
+        return N - 1;
+    }
+};
+
+namespace detail {
+
+template<route_literal Pattern, class H>
+struct static_route_entry
+{
+    using handler_type = H;
+
+    // the lengths match() compares
+    static constexpr std::size_t strict_size = Pattern.size();
+    static constexpr std::size_t loose_size = Pattern.loose_size();
+
+    http::method verb; // unknown for all methods
+    H h;
+
+    // Compare a length known at compile time,
+    // so each memcmp is expanded inline.
+    template<std::size_t K>
+    static
+    bool
+    equal(
+        char const* s,
+        char const* pat) noexcept
+    {
+        return std::memcmp(s, pat, K) == 0;
+    }
+
+    bool
+    match(
+        route_params_base const& p,
+        char const* s,
+        std::size_t n) const noexcept
+    {
+        constexpr std::size_t N = Pattern.size();
+        constexpr std::size_t L = Pattern.loose_size();
+        char const* const pat = p.case_sensitive ?
+            Pattern.s : Pattern.lower;
+        if(p.strict)
+        {
+            if(n != N || ! equal<N>(s, pat))
+                return false;
+        }
+        else
+        {
+            if(n != L || ! equal<L>(s, pat))
+                return false;
+        }
+        return
+            verb == http::method::unknown ||
+            p.is_method(verb);
+    }
+};
+
+template<class P, class... Routes>
+using static_routes_result = std::conditional_t<
+    (returns_route_result<
+        typename Routes::handler_type const&, P&> && ...),
+    route_result, route_task>;
+
+} // detail
+
+/** Return a route for a @ref static_routes table
+
+    The returned route matches any method.
+
+    @par Example
+    @code
+    static_route<"/health">(
+        []( route_params& p ) -> route_result
+        {
+            ...
+        } );
+    @endcode
+
+    @tparam Pattern The pattern, checked at compile time.
+
+    @param h The handler.
+*/
+template<route_literal Pattern, class H>
+auto
+static_route(H&& h) ->
+    detail::static_route_entry<Pattern, std::decay_t<H>>
+{
+    return { http::method::unknown, std::forward<H>(h) };
+}
+
+/** Return a route for a @ref static_routes table
+
+    The returned route matches only the method `verb`.
+
+    @par Example
+    @code
+    static_route<"/health">( method::get, health );
+    @endcode
+
+    @tparam Pattern The pattern, checked at compile time.
+
+    @param verb The method to match. This may not
+    be @ref method::unknown.
+
+    @param h The handler.
+*/
+template<route_literal Pattern, class H>
+auto
+static_route(
+    http::method verb,
+    H&& h) ->
+        detail::static_route_entry<Pattern, std::decay_t<H>>
+{
+    BOOST_ASSERT(verb != http::method::unknown);
+    return { verb, std::forward<H>(h) };
+}
+
+/** A fixed set of routes matched by generated code
+
+    This handler holds a list of routes whose patterns
+    are known at compile time. The matcher is generated
+    from the list: the length of the path selects the
+    routes of that length, each of these compares the
+    pattern with a `memcmp` whose size is a constant,
+    and the handler is called directly. There are no matcher objects and no
+    virtual calls between the request and the handler.
+
+    The table is added to a @ref basic_router as a
+    single handler, usually with `use`. It matches
+    against @ref route_params_base::path, which is
+    the path relative to the mount point, using the
+    case sensitivity and strictness in effect there.
+    Routes are tried in order, the first route whose
+    pattern and method match is invoked, and its
+    result is returned. When no route matches the
+    table returns @ref route_next.
+
+    When every handler returns @ref route_result, the
+    table does too, and it is called without creating
+    a coroutine frame.
+
+    @par Example
+    @code
+    router r;
+    r.use( "/api", static_routes(
+        static_route<"/health">( method::get, health ),
+        static_route<"/metrics">( method::get, metrics ),
+        static_route<"/login">( method::post, login ) ) );
+    @endcode
+
+    @see
+        @ref route_literal,
+        @ref static_route.
+*/
+template<class... Routes>
+class static_routes
+{
+    std::tuple<Routes...> r_;
+
+    template<class R, class H, class P>
+    static
+    R
+    call(H const& h, P& p)
+    {
+        if constexpr(
+            std::is_same_v<R, route_result> ||
+            detail::returns_route_task<H const&, P&>)
+            return h(p);
+        else
+            return detail::make_route_task(h(p));
+    }
+
+    template<class R>
+    static
+    R
+    next()
+    {
+        if constexpr(std::is_same_v<R, route_result>)
+            return route_next;
+        else
+            return detail::make_route_task(route_next);
+    }
+
+    template<bool Strict>
+    static constexpr auto lengths_ =
+        detail::make_route_lengths<Strict, Routes...>();
+
+    // Try, in order, the routes which compare Len
+    // characters. The others cannot match.
+    template<class R, bool Strict, std::size_t Len, std::size_t I, class P>
+    R
+    invoke(
+        P& p,
+        char const* s) const
+    {
+        if constexpr(I == sizeof...(Routes))
+        {
+            return next<R>();
+        }
+        else
+        {
+            using route = std::tuple_element_t<
+                I, std::tuple<Routes...>>;
+            if constexpr((Strict ?
+                route::strict_size : route::loose_size) == Len)
+            {
+                auto const& r = std::get<I>(r_);
+                if(r.match(p, s, Len))
+                    return call<R>(r.h, p);
+            }
+            return invoke<R, Strict, Len, I + 1>(p, s);
+        }
+    }
+
+    // Select the routes by the length of the path,
+    // comparing against the sorted distinct lengths
+    template<class R, bool Strict, std::size_t K, class P>
+    R
+    select(
+        P& p,
+        char const* s,
+        std::size_t n) const
+    {
+        constexpr auto const& lens = lengths_<Strict>;
+        if constexpr(K == lens.count)
+        {
+            return next<R>();
+        }
+        else
+        {
+            if(n < lens.v[K])
+                return next<R>();
+            if(n == lens.v[K])
+                return invoke<R, Strict, lens.v[K], 0>(p, s);
+            return select<R, Strict, K + 1>(p, s, n);
+        }
+    }
+
+public:
+    /** Constructor.
+
+        @param r The routes, tried in order.
+    */
+    explicit
+    static_routes(Routes... r)
+        : r_(std::move(r)...)
+    {
+    }
+
+    /** Invoke the route matching the request
+    */
+    template<class P>
+        requires std::derived_from<P, route_params_base>
+    auto
+    operator()(P& p) const ->
+        detail::static_routes_result<P, Routes...>
+    {
+        using R = detail::static_routes_result<P, Routes...>;
+        char const* s = p.path.data();
+        std::size_t n = p.path.size();
+        if(! p.case_sensitive)
+        {
+            // compare against the path folded by the router
+            BOOST_ASSERT(
+                p.lowered_path_.size() == p.decoded_path_.size());
+            s = p.lowered_path_.data() +
+                (s - p.decoded_path_.data());
+        }
+        if(p.strict)
+            return select<R, true, 0>(p, s, n);
+        if(n > 1 && s[n - 1] == '/')
+            --n;
+        return select<R, false, 0>(p, s, n);
+    }
+};
+
+} // http
+} // boost
+
+#endif
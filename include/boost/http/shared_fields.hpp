@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2025 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SHARED_FIELDS_HPP
+#define BOOST_HTTP_SHARED_FIELDS_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/fields.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <memory>
+
+namespace boost {
+namespace http {
+
+/** An immutable, reference-counted block of HTTP fields.
+
+    Objects of this type hold a frozen copy of
+    a set of fields which is shared by every
+    copy of the object. It is intended for the
+    large set of fields common to many responses,
+    such as security policy, CORS, cache policy
+    or the server name. A @ref response_base
+    may reference a block with
+    @ref response_base::set_shared_fields.
+    The fields of the response then act as an
+    overlay: they shadow the fields of the block
+    with the same name, and the remaining fields
+    of the block follow them when iterating and
+    serializing. The serializer emits the block
+    from its own buffer, without copying.
+
+    Copies are cheap and safe to make from
+    multiple threads concurrently. The block
+    is destroyed when the last copy goes away.
+
+    Fields which affect message framing or
+    the metadata of the message (Connection,
+    Content-Encoding, Content-Length, Expect,
+    Transfer-Encoding and Upgrade) cannot be
+    placed in a shared block; they must be
+    set on the message itself.
+
+    @par Example
+    @code
+    fields f;
+    f.append({
+        { field::server, "Boost" },
+        { field::strict_transport_security, "max-age=31536000" } });
+    f.append("X-Content-Type-Options", "nosniff");
+    shared_fields const common(f);
+
+    response res;
+    res.set_shared_fields(common);
+    res.set(field::content_type, "text/html");
+    @endcode
+
+    @see
+        @ref fields,
+        @ref response_base.
+*/
+class shared_fields
+{
+    std::shared_ptr<fields const> p_;
+
+public:
+    /** Constructor.
+
+        Default-constructed objects hold an
+        empty block.
+
+        @par Postconditions
+        @code
+        this->empty() && this->buffer() == "\r\n"
+        @endcode
+
+        @par Complexity
+        Constant.
+    */
+    shared_fields() noexcept = default;
+
+    /** Constructor.
+
+        The fields in `f` are copied into a new
+        block, which is allocated once.
+
+        @par Postconditions
+        @code
+        this->buffer() == f.buffer()
+        @endcode
+
+        @par Complexity
+        Linear in `f.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+        Exception thrown on invalid input.
+
+        @throw std::invalid_argument
+        `f` contains a field which affects
+        message metadata.
+
+        @param f The fields to copy.
+    */
+    BOOST_HTTP_DECL
+    explicit
+    shared_fields(fields const& f);
+
+    /** Return true if the block contains no fields.
+    */
+    bool
+    empty() const noexcept
+    {
+        return ! p_ || p_->size() == 0;
+    }
+
+    /** Return the serialized fields.
+
+        The returned string includes the
+        terminating empty line. It remains
+        valid for as long as any copy of
+        this object exists.
+    */
+    core::string_view
+    buffer() const noexcept
+    {
+        return get().buffer();
+    }
+
+    /** Return the fields in the block.
+
+        The returned reference remains valid
+        for as long as any copy of this object
+        exists.
+    */
+    BOOST_HTTP_DECL
+    fields const&
+    get() const noexcept;
+
+    /** Return the number of objects sharing the block.
+
+        Returns zero for a default-constructed
+        object.
+    */
+    long
+    use_count() const noexcept
+    {
+        return p_.use_count();
+    }
+
+    /** Swap.
+
+        @par Complexity
+        Constant.
+
+        @param other The object to swap with.
+    */
+    void
+    swap(shared_fields& other) noexcept
+    {
+        p_.swap(other.p_);
+    }
+};
+
+} // http
+} // boost
+
+#endif
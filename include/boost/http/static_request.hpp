@@ -116,6 +116,7 @@ public:
         : request_base()
     {
         h_.swap(r.h_);
+        ++r.gen_;
         external_storage_ = true;
         max_cap_ = r.max_cap_;
         r.max_cap_ = 0;
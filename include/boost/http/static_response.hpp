@@ -115,6 +115,8 @@ public:
         : response_base()
     {
         h_.swap(r.h_);
+        sf_.swap(r.sf_);
+        std::swap(ext_, r.ext_);
         external_storage_ = true;
         max_cap_ = r.max_cap_;
         r.max_cap_ = 0;
@@ -150,6 +152,8 @@ public:
         static_response const& r)
     {
         copy_impl(r.h_);
+        sf_ = r.sf_;
+        attach_shared_fields();
         return *this;
     }
 
@@ -183,6 +187,8 @@ public:
         response_base const& r)
     {
         copy_impl(r.h_);
+        sf_ = r.sf_;
+        attach_shared_fields();
         return *this;
     }
 };
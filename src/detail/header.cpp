@@ -143,6 +143,7 @@ swap(header& h) noexcept
     std::swap(size, h.size);
     std::swap(count, h.count);
     std::swap(prefix, h.prefix);
+    std::swap(dead, h.dead);
     std::swap(version, h.version);
     std::swap(md, h.md);
     switch(kind)
@@ -347,6 +348,156 @@ assign_to(
     dest.cap = cap_;
 }
 
+// return the index of the first entry at or
+// after i which is not dead, or count
+std::size_t
+header::
+next_live(
+    std::size_t i) const noexcept
+{
+    auto const ft = tab();
+    while(i < count && ft[i].id == dead_field)
+        ++i;
+    return i;
+}
+
+// return one past the index of the last entry
+// before i which is not dead, or zero
+std::size_t
+header::
+prev_live(
+    std::size_t i) const noexcept
+{
+    auto const ft = tab();
+    while(i > 0 && ft[i - 1].id == dead_field)
+        --i;
+    return i;
+}
+
+// return true if a live entry has the
+// name of entry j of the external block
+bool
+header::
+shadows(
+    header const& ext,
+    std::size_t j) const noexcept
+{
+    auto const& e = ext.tab()[j];
+    if(e.id != unknown_field)
+        return find(e.id) != count;
+    core::string_view const name(
+        ext.cbuf + ext.prefix + e.np, e.nn);
+    auto const ft = tab();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        // a known name never equals an unknown one
+        if(ft[i].id != unknown_field)
+            continue;
+        if(grammar::ci_is_equal(
+            core::string_view(
+                cbuf + prefix + ft[i].np,
+                ft[i].nn), name))
+            return true;
+    }
+    return false;
+}
+
+// return the first visible index at or after
+// i, where the entries of `ext` follow ours
+std::size_t
+header::
+next_visible(
+    header const* ext,
+    std::size_t i) const noexcept
+{
+    if(i < count)
+    {
+        if(dead != 0)
+            i = next_live(i);
+        if(i < count || ! ext)
+            return i;
+    }
+    if(! ext)
+        return i;
+    BOOST_ASSERT(ext->dead == 0);
+    auto j = i - count;
+    while(j < ext->count && shadows(*ext, j))
+        ++j;
+    return count + j;
+}
+
+// return one past the last visible index
+// before i, where the entries of `ext`
+// follow ours
+std::size_t
+header::
+prev_visible(
+    header const* ext,
+    std::size_t i) const noexcept
+{
+    if(ext && i > count)
+    {
+        auto j = i - count;
+        while(j > 0 && shadows(*ext, j - 1))
+            --j;
+        if(j > 0)
+            return count + j;
+        i = count;
+    }
+    if(dead != 0)
+        return prev_live(i);
+    return i;
+}
+
+// return the number of visible entries
+std::size_t
+header::
+visible_count(
+    header const* ext) const noexcept
+{
+    std::size_t n = count - dead;
+    if(! ext)
+        return n;
+    for(std::size_t j = 0; j < ext->count; ++j)
+        if(! shadows(*ext, j))
+            ++n;
+    return n;
+}
+
+// remove the fields of dead entries
+void
+header::
+compact() noexcept
+{
+    if(dead == 0)
+        return;
+    BOOST_ASSERT(buf != nullptr);
+    auto const ft = tab();
+    std::size_t pos = prefix;
+    std::size_t j = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        auto const p0 = prefix + ft[i].np;
+        auto const p1 = (i + 1 < count)
+            ? prefix + ft[i + 1].np
+            : size - 2;
+        if(ft[i].id == dead_field)
+            continue;
+        if(pos != p0)
+            std::memmove(
+                buf + pos,
+                buf + p0,
+                p1 - p0);
+        ft[j++] = ft[i] - (p0 - pos);
+        pos += p1 - p0;
+    }
+    buf[pos++] = '\r';
+    buf[pos++] = '\n';
+    size = static_cast<offset_type>(pos);
+    count = static_cast<offset_type>(j);
+    dead = 0;
+}
+
 //------------------------------------------------
 //
 // Metadata
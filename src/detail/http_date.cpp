@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include "src/detail/http_date.hpp"
+
+namespace boost {
+namespace http {
+namespace detail {
+
+namespace {
+
+// Days from 1970-01-01 to the given civil date
+constexpr
+std::int64_t
+days_from_civil(int y, int m, int d) noexcept
+{
+    y -= m <= 2;
+    std::int64_t const era = (y >= 0 ? y : y - 399) / 400;
+    int const yoe = static_cast<int>(y - era * 400);
+    int const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    int const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static_assert(days_from_civil(1970, 1, 1) == 0);
+static_assert(days_from_civil(2000, 3, 1) == 11017);
+
+// Consumes the parts of an HTTP-date
+class date_parser
+{
+    core::string_view s_;
+
+public:
+    explicit
+    date_parser(core::string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    bool
+    done() const noexcept
+    {
+        return s_.empty();
+    }
+
+    bool
+    lit(core::string_view s) noexcept
+    {
+        if(! s_.starts_with(s))
+            return false;
+        s_.remove_prefix(s.size());
+        return true;
+    }
+
+    // exactly n digits
+    bool
+    num(std::size_t n, int& v) noexcept
+    {
+        if(s_.size() < n)
+            return false;
+        v = 0;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            if(s_[i] < '0' || s_[i] > '9')
+                return false;
+            v = v * 10 + (s_[i] - '0');
+        }
+        s_.remove_prefix(n);
+        return true;
+    }
+
+    bool
+    day_name(bool full) noexcept
+    {
+        static constexpr core::string_view names[] = {
+            "Monday", "Tuesday", "Wednesday", "Thursday",
+            "Friday", "Saturday", "Sunday" };
+        for(auto name : names)
+            if(lit(full ? name : name.substr(0, 3)))
+                return true;
+        return false;
+    }
+
+    bool
+    month(int& m) noexcept
+    {
+        static constexpr core::string_view names[] = {
+            "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+            "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        for(int i = 0; i < 12; ++i)
+        {
+            if(lit(names[i]))
+            {
+                m = i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // hour ":" minute ":" second
+    bool
+    time(int& h, int& mi, int& sec) noexcept
+    {
+        return
+            num(2, h) && lit(":") &&
+            num(2, mi) && lit(":") &&
+            num(2, sec);
+    }
+};
+
+struct date_parts
+{
+    int y = 0;
+    int mo = 0;
+    int d = 0;
+    int h = 0;
+    int mi = 0;
+    int sec = 0;
+};
+
+// Sun, 06 Nov 1994 08:49:37 GMT
+bool
+parse_imf_fixdate(
+    core::string_view s,
+    date_parts& v) noexcept
+{
+    date_parser p(s);
+    return
+        p.day_name(false) && p.lit(", ") &&
+        p.num(2, v.d) && p.lit(" ") &&
+        p.month(v.mo) && p.lit(" ") &&
+        p.num(4, v.y) && p.lit(" ") &&
+        p.time(v.h, v.mi, v.sec) &&
+        p.lit(" GMT") && p.done();
+}
+
+// Sunday, 06-Nov-94 08:49:37 GMT
+bool
+parse_rfc850_date(
+    core::string_view s,
+    date_parts& v) noexcept
+{
+    date_parser p(s);
+    if(! (
+        p.day_name(true) && p.lit(", ") &&
+        p.num(2, v.d) && p.lit("-") &&
+        p.month(v.mo) && p.lit("-") &&
+        p.num(2, v.y) && p.lit(" ") &&
+        p.time(v.h, v.mi, v.sec) &&
+        p.lit(" GMT") && p.done()))
+        return false;
+    v.y += v.y < 70 ? 2000 : 1900;
+    return true;
+}
+
+// Sun Nov  6 08:49:37 1994
+bool
+parse_asctime_date(
+    core::string_view s,
+    date_parts& v) noexcept
+{
+    date_parser p(s);
+    return
+        p.day_name(false) && p.lit(" ") &&
+        p.month(v.mo) && p.lit(" ") &&
+        (p.lit(" ") ? p.num(1, v.d) : p.num(2, v.d)) &&
+        p.lit(" ") &&
+        p.time(v.h, v.mi, v.sec) && p.lit(" ") &&
+        p.num(4, v.y) && p.done();
+}
+
+} // (anon)
+
+bool
+parse_http_date(
+    core::string_view s,
+    std::uint64_t& t) noexcept
+{
+    date_parts v;
+    if(! parse_imf_fixdate(s, v) &&
+        ! parse_rfc850_date(s, v) &&
+        ! parse_asctime_date(s, v))
+        return false;
+    if( v.y < 1970 ||
+        v.d < 1 || v.d > 31 ||
+        v.h > 23 || v.mi > 59 || v.sec > 60)
+        return false;
+    t = static_cast<std::uint64_t>(
+        days_from_civil(v.y, v.mo, v.d)) * 86400 +
+        static_cast<std::uint64_t>(
+            v.h * 3600 + v.mi * 60 + v.sec);
+    return true;
+}
+
+} // detail
+} // http
+} // boost
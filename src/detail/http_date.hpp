@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_DETAIL_HTTP_DATE_HPP
+#define BOOST_HTTP_DETAIL_HTTP_DATE_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdint>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Parse an HTTP-date in any of the three formats
+// of RFC 9110, as seconds since the epoch.
+bool
+parse_http_date(
+    core::string_view s,
+    std::uint64_t& t) noexcept;
+
+} // detail
+} // http
+} // boost
+
+#endif
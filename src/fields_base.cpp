@@ -109,12 +109,13 @@ public:
         , s0_(s0)
         , s1_(s1)
     {
+        ++self_.gen_;
     }
 
     ~op_t()
     {
         if(buf_)
-            delete[] buf_;
+            self_.deallocate(buf_, cap_);
     }
 
     char const*
@@ -162,7 +163,6 @@ op_t::
 reserve(
     std::size_t n)
 {
-    // TODO: consider using a growth factor
     if(n > self_.max_cap_)
     {
         // max capacity exceeded
@@ -170,7 +170,7 @@ reserve(
     }
     if(n <= self_.h_.cap)
         return false;
-    auto buf = new char[n];
+    auto buf = self_.allocate(n);
     buf_ = self_.h_.buf;
     cbuf_ = self_.h_.cbuf;
     cap_ = self_.h_.cap;
@@ -193,10 +193,14 @@ grow(
     if(extra_char > detail::header::max_offset - self_.h_.size)
         detail::throw_length_error();
 
-    return reserve(
+    auto const n =
         detail::header::bytes_needed(
             self_.h_.size + extra_char,
-            self_.h_.count + extra_field));
+            self_.h_.count + extra_field);
+    if(n <= self_.h_.cap)
+        return false;
+    return reserve(
+        self_.next_capacity(n));
 }
 
 void
@@ -224,6 +228,7 @@ prefix_op_t(
     , new_prefix_(static_cast<
         offset_type>(new_prefix))
 {
+    ++self.gen_;
     if(self.h_.size - self.h_.prefix + new_prefix
         > detail::header::max_offset)
         detail::throw_length_error();
@@ -248,20 +253,22 @@ prefix_op_t(
         // intended since they cannot reallocate.
         if(self.max_cap_ < bytes_needed)
             detail::throw_length_error();
-        // TODO: consider using a growth factor
-        char* p = new char[bytes_needed];
+        auto const n =
+            self.next_capacity(bytes_needed);
+        char* p = self.allocate(n);
         std::memcpy(
             p + new_prefix_,
             self.h_.cbuf + self.h_.prefix,
             self.h_.size - self.h_.prefix);
-        self.h_.copy_table(p + bytes_needed);
+        self.h_.copy_table(p + n);
 
         // old buffer gets released in the destructor
         // to avoid invalidating any string_views
         // that may still reference it.
         buf_        = self.h_.buf;
+        cap_        = self.h_.cap;
         self.h_.buf = p;
-        self.h_.cap = bytes_needed;
+        self.h_.cap = n;
     }
     else
     {
@@ -297,7 +304,7 @@ prefix_op_t::
     }
     else if(buf_)
     {
-        delete[] buf_;
+        self_.deallocate(buf_, cap_);
     }
 }
 
@@ -310,6 +317,15 @@ fields_base(
 {
 }
 
+fields_base::
+fields_base(
+    detail::kind k,
+    std::pmr::memory_resource* mr) noexcept
+    : h_(k)
+    , mr_(mr)
+{
+}
+
 fields_base::
 fields_base(
     detail::kind k,
@@ -354,19 +370,23 @@ fields_base(
 // construct a complete copy of h
 fields_base::
 fields_base(
-    detail::header const& h)
+    detail::header const& h,
+    std::pmr::memory_resource* mr)
     : h_(h.kind)
+    , mr_(mr)
 {
     if(h.is_default())
         return;
 
-    // allocate and copy the buffer
+    // allocate and copy the buffer, then
+    // drop any erased fields from the copy
     op_t op(*this);
     op.grow(h.size, h.count);
     h.assign_to(h_);
     std::memcpy(
         h_.buf, h.cbuf, h.size);
     h.copy_table(h_.buf + h_.cap);
+    h_.compact();
 }
 
 // construct a complete copy of h
@@ -395,6 +415,7 @@ fields_base(
     std::memcpy(
         h_.buf, h.cbuf, h.size);
     h.copy_table(h_.buf + h_.cap);
+    h_.compact();
 }
 
 //------------------------------------------------
@@ -409,7 +430,7 @@ fields_base::
 ~fields_base()
 {
     if(h_.buf && !external_storage_)
-        delete[] h_.buf;
+        deallocate(h_.buf, h_.cap);
 }
 
 //------------------------------------------------
@@ -424,6 +445,7 @@ clear() noexcept
 {
     if(! h_.buf)
         return;
+    ++gen_;
     using H =
         detail::header;
     auto const& h =
@@ -467,7 +489,9 @@ shrink_to_fit()
     if(external_storage_)
         return;
 
-    fields_base tmp(h_);
+    ++gen_;
+    h_.compact();
+    fields_base tmp(h_, mr_);
     tmp.h_.swap(h_);
 }
 
@@ -500,19 +524,16 @@ value_type(
 
 //------------------------------------------------
 
-auto
-fields_base::
-iterator::
-operator*() const noexcept ->
-    reference
+namespace {
+
+// return a view to entry i of h
+fields_base::reference
+make_reference(
+    detail::header const& h,
+    std::size_t i) noexcept
 {
-    BOOST_ASSERT(i_ < ph_->count);
-    auto tab =
-        ph_->tab();
-    auto const& e =
-        tab[i_];
-    auto const* p =
-        ph_->cbuf + ph_->prefix;
+    auto const& e = h.tab()[i];
+    auto const* p = h.cbuf + h.prefix;
     return {
         (e.id == detail::header::unknown_field)
             ? optional<field>{} : e.id,
@@ -522,6 +543,22 @@ operator*() const noexcept ->
             p + e.vp, e.vn) };
 }
 
+} // (anon)
+
+auto
+fields_base::
+iterator::
+operator*() const noexcept ->
+    reference
+{
+    if(i_ < ph_->count)
+        return make_reference(*ph_, i_);
+    BOOST_ASSERT(pe_ &&
+        i_ - ph_->count < pe_->count);
+    return make_reference(
+        *pe_, i_ - ph_->count);
+}
+
 //------------------------------------------------
 
 auto
@@ -531,19 +568,12 @@ operator*() const noexcept ->
     reference
 {
     BOOST_ASSERT(i_ > 0);
-    auto tab =
-      ph_->tab();
-    auto const& e =
-        tab[i_-1];
-    auto const* p =
-        ph_->cbuf + ph_->prefix;
-    return {
-        (e.id == detail::header::unknown_field)
-            ? optional<field>{} : e.id,
-        core::string_view(
-            p + e.np, e.nn),
-        core::string_view(
-            p + e.vp, e.vn) };
+    if(i_ <= ph_->count)
+        return make_reference(*ph_, i_ - 1);
+    BOOST_ASSERT(pe_ &&
+        i_ - ph_->count <= pe_->count);
+    return make_reference(
+        *pe_, i_ - ph_->count - 1);
 }
 
 //------------------------------------------------
@@ -553,20 +583,26 @@ subrange::
 iterator::
 iterator(
     detail::header const* ph,
+    detail::header const* pe,
     std::size_t i) noexcept
     : ph_(ph)
+    , pe_(pe)
     , i_(i)
 {
-    BOOST_ASSERT(i <= ph_->count);
+    BOOST_ASSERT(i <= ph_->count +
+        (pe_ ? pe_->count : 0));
 }
 
 fields_base::
 subrange::
 iterator::
 iterator(
-    detail::header const* ph) noexcept
+    detail::header const* ph,
+    detail::header const* pe) noexcept
     : ph_(ph)
-    , i_(ph->count)
+    , pe_(pe)
+    , i_(ph->count +
+        (pe ? pe->count : 0))
 {
 }
 
@@ -577,16 +613,13 @@ iterator::
 operator*() const noexcept ->
     reference const
 {
-    auto tab =
-        ph_->tab();
-    auto const& e =
-        tab[i_];
-    auto const p =
-        ph_->cbuf + ph_->prefix;
-    return core::string_view(
-        p + e.vp, e.vn);
+    return fields_base::iterator(
+        ph_, pe_, i_)->value;
 }
 
+// The matches are either all in our fields,
+// or, when the name is missing there, all in
+// the external block; the rest are shadowed.
 auto
 fields_base::
 subrange::
@@ -594,37 +627,36 @@ iterator::
 operator++() noexcept ->
     iterator&
 {
-    BOOST_ASSERT(i_ < ph_->count);
-    auto const* e = &ph_->tab()[i_];
-    auto const id = e->id;
-    if(id != detail::header::unknown_field)
+    auto const in_ext = i_ >= ph_->count;
+    auto const& h = in_ext ? *pe_ : *ph_;
+    auto const base = in_ext ? ph_->count : 0;
+    auto const end = ph_->count +
+        (pe_ ? pe_->count : 0);
+    BOOST_ASSERT(i_ - base < h.count);
+    auto const ft = h.tab();
+    auto const id = ft[i_ - base].id;
+    auto const p = h.cbuf + h.prefix;
+    auto const name = core::string_view(
+        p + ft[i_ - base].np, ft[i_ - base].nn);
+    for(auto j = i_ - base + 1; j < h.count; ++j)
     {
-        ++i_;
-        --e;
-        while(i_ != ph_->count)
+        auto const& e = ft[j];
+        if(id != detail::header::unknown_field)
         {
-            if(e->id == id)
-                break;
-            ++i_;
-            --e;
+            if(e.id != id)
+                continue;
         }
+        else if(
+            e.id != detail::header::unknown_field ||
+            ! grammar::ci_is_equal(name,
+                core::string_view(p + e.np, e.nn)))
+        {
+            continue;
+        }
+        i_ = base + j;
         return *this;
     }
-    auto const p =
-        ph_->cbuf + ph_->prefix;
-    auto name = core::string_view(
-        p + e->np, e->nn);
-    ++i_;
-    --e;
-    while(i_ != ph_->count)
-    {
-        if(grammar::ci_is_equal(
-            name, core::string_view(
-                p + e->np, e->nn)))
-            break;
-        ++i_;
-        --e;
-    }
+    i_ = end;
     return *this;
 }
 
@@ -837,7 +869,7 @@ find_all(
         subrange
 {
     return subrange(
-        &h_, find(id).i_);
+        &h_, ext_, find(id).i_);
 }
 
 auto
@@ -847,7 +879,7 @@ find_all(
         subrange
 {
     return subrange(
-        &h_, find(name).i_);
+        &h_, ext_, find(name).i_);
 }
 
 std::ostream&
@@ -875,10 +907,14 @@ fields_base::
 erase(
     iterator it) noexcept -> iterator
 {
+    // only our own fields can be erased
+    BOOST_ASSERT(it.i_ < h_.count);
     auto const id = it->id.value_or(
         detail::header::unknown_field);
     raw_erase(it.i_);
     h_.on_erase(id);
+    if(h_.dead != 0 || ext_)
+        it.i_ = h_.next_visible(ext_, it.i_);
     return it;
 }
 
@@ -890,6 +926,10 @@ erase(
     auto const i0 = h_.find(id);
     if(i0 == h_.count)
         return 0;
+    if( deferred_ &&
+        ! h_.is_special(id))
+        return tombstone_all(
+            i0, h_.count, id);
     return erase_all(i0, id);
 }
 
@@ -904,7 +944,16 @@ erase(
     auto const ft = h_.tab();
     auto const id = ft[i0].id;
     if(id == detail::header::unknown_field)
+    {
+        if(deferred_)
+            return tombstone_all(
+                i0, h_.count, name);
         return erase_all(i0, name);
+    }
+    if( deferred_ &&
+        ! h_.is_special(id))
+        return tombstone_all(
+            i0, h_.count, id);
     return erase_all(i0, id);
 }
 
@@ -917,6 +966,10 @@ set(
     core::string_view value,
     system::error_code& ec)
 {
+    // a shared field is shadowed instead
+    if(it.i_ >= h_.count)
+        return set(it->name, value, ec);
+
     auto rv = verify_field_value(value);
     if(rv.has_error())
     {
@@ -1048,6 +1101,22 @@ set(
         return;
     }
 
+    if( deferred_ &&
+        ! h_.is_special(id))
+    {
+        // append first for the strong
+        // guarantee, then retire the rest
+        insert_unchecked(
+            id,
+            to_string(id),
+            rv->value,
+            h_.count,
+            rv->has_obs_fold);
+        tombstone_all(
+            h_.find(id), h_.count - 1, id);
+        return;
+    }
+
     auto const i0 = h_.find(id);
     if(i0 != h_.count)
     {
@@ -1094,6 +1163,27 @@ set(
         return;
     }
 
+    auto const id = string_to_field(name);
+    if( deferred_ && (! id ||
+        ! h_.is_special(*id)))
+    {
+        // append first for the strong
+        // guarantee, then retire the rest
+        insert_unchecked(
+            id,
+            name,
+            rv->value,
+            h_.count,
+            rv->has_obs_fold);
+        if(id)
+            tombstone_all(
+                h_.find(*id), h_.count - 1, *id);
+        else
+            tombstone_all(
+                h_.find(name), h_.count - 1, name);
+        return;
+    }
+
     auto const i0 = h_.find(name);
     if(i0 != h_.count)
     {
@@ -1149,6 +1239,10 @@ insert(
     system::error_code& ec)
     -> iterator
 {
+    // fields are inserted ahead of the
+    // fields of the external block
+    if(before.i_ > h_.count)
+        before.i_ = h_.count;
     insert_impl(
         id,
         to_string(id),
@@ -1166,10 +1260,10 @@ insert(
     -> iterator
 {
     system::error_code ec;
-    insert(before, name, value, ec);
+    auto const it = insert(before, name, value, ec);
     if(ec)
         detail::throw_system_error(ec);
-    return before;
+    return it;
 }
 
 auto
@@ -1181,6 +1275,8 @@ insert(
     system::error_code& ec)
     -> iterator
 {
+    if(before.i_ > h_.count)
+        before.i_ = h_.count;
     insert_impl(
         string_to_field(name),
         name,
@@ -1217,6 +1313,7 @@ copy_impl(
     BOOST_ASSERT(
         h.kind == h_.kind);
 
+    ++gen_;
     auto const n =
         detail::header::bytes_needed(
             h.size, h.count);
@@ -1230,6 +1327,7 @@ copy_impl(
             h_.buf,
             h.cbuf,
             h.size);
+        h_.compact();
         return;
     }
 
@@ -1237,7 +1335,7 @@ copy_impl(
     if(external_storage_)
         detail::throw_length_error();
 
-    fields_base tmp(h);
+    fields_base tmp(h, mr_);
     tmp.h_.swap(h_);
 }
 
@@ -1269,6 +1367,111 @@ insert_impl(
         rv->has_obs_fold);
 }
 
+void
+fields_base::
+append_impl(
+    std::pair<field, core::string_view> const* p,
+    std::size_t n,
+    system::error_code& ec)
+{
+    if(n == 0)
+        return;
+
+    // upper bound, assumes every value is
+    // non-empty and has nothing to trim
+    std::size_t extra = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const len =
+            to_string(p[i].first).size() +
+            p[i].second.size() + 4;
+        if(len > detail::header::max_offset - extra)
+            detail::throw_length_error();
+        extra += len;
+    }
+
+    auto const count0 = h_.count;
+    auto const size0 = h_.size;
+    auto const tab0 = h_.tab_();
+
+    op_t op(*this);
+    if(op.grow(extra, n))
+    {
+        // reallocated
+        std::memcpy(
+            h_.buf,
+            op.cbuf(),
+            size0);
+        if(count0 > 0)
+            std::memcpy(
+                h_.tab_() - count0,
+                tab0 - count0,
+                count0 * sizeof(entry));
+    }
+
+    // serialize over the final CRLF, the
+    // container is not updated until every
+    // value has been validated
+    auto const tab = h_.tab_();
+    auto dest = h_.buf + size0 - 2;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto rv = verify_field_value(
+            p[i].second);
+        if(rv.has_error())
+        {
+            h_.buf[size0 - 2] = '\r';
+            h_.buf[size0 - 1] = '\n';
+            ec = rv.error();
+            return;
+        }
+
+        auto const name = to_string(p[i].first);
+        auto const value = rv->value;
+        auto& e = tab[0 - static_cast<
+            std::ptrdiff_t>(count0 + i) - 1];
+        e.np = static_cast<offset_type>(
+            dest - h_.buf - h_.prefix);
+        e.nn = static_cast<
+            offset_type>(name.size());
+        name.copy(dest, name.size());
+        dest += name.size();
+        *dest++ = ':';
+        if(! value.empty())
+        {
+            *dest++ = ' ';
+            value.copy(
+                dest, value.size());
+            if( rv->has_obs_fold )
+                detail::remove_obs_fold(
+                    dest, dest + value.size());
+        }
+        e.vp = static_cast<offset_type>(
+            dest - h_.buf - h_.prefix);
+        e.vn = static_cast<
+            offset_type>(value.size());
+        e.id = p[i].first;
+        dest += value.size();
+        *dest++ = '\r';
+        *dest++ = '\n';
+    }
+    *dest++ = '\r';
+    *dest++ = '\n';
+
+    // update container
+    h_.count = static_cast<
+        offset_type>(h_.count + n);
+    h_.size = static_cast<
+        offset_type>(dest - h_.buf);
+    for(std::size_t i = count0; i < h_.count; ++i)
+    {
+        auto const& e = tab[0 -
+            static_cast<std::ptrdiff_t>(i) - 1];
+        h_.on_insert(e.id, core::string_view(
+            h_.buf + h_.prefix + e.vp, e.vn));
+    }
+}
+
 void
 fields_base::
 insert_unchecked(
@@ -1278,8 +1481,6 @@ insert_unchecked(
     std::size_t before,
     bool has_obs_fold)
 {
-    auto const tab0 = h_.tab_();
-    auto const pos = offset(before);
     auto const n =
         name.size() +       // name
         1 +                 // ':'
@@ -1287,6 +1488,19 @@ insert_unchecked(
         value.size() +      // value
         2;                  // CRLF
 
+    // reclaim erased fields before growing
+    if( h_.dead != 0 &&
+        before == h_.count &&
+        detail::header::bytes_needed(
+            h_.size + n, h_.count + 1) > h_.cap)
+    {
+        h_.compact();
+        before = h_.count;
+    }
+
+    auto const tab0 = h_.tab_();
+    auto const pos = offset(before);
+
     op_t op(*this, &name, &value);
     if(op.grow(n, 1))
     {
@@ -1377,6 +1591,7 @@ raw_erase(
 {
     BOOST_ASSERT(i < h_.count);
     BOOST_ASSERT(h_.buf != nullptr);
+    ++gen_;
     auto const p0 = offset(i);
     auto const p1 = offset(i + 1);
     std::memmove(
@@ -1473,6 +1688,61 @@ erase_all(
     return n;
 }
 
+// mark fields in [i0, i1) matching id
+// as dead without moving the buffer
+std::size_t
+fields_base::
+tombstone_all(
+    std::size_t i0,
+    std::size_t i1,
+    field id) noexcept
+{
+    ++gen_;
+    std::size_t n = 0;
+    auto const ft = h_.tab();
+    for(auto i = i0; i < i1; ++i)
+    {
+        auto& e = ft[i];
+        if(e.id != id)
+            continue;
+        e.id = detail::header::dead_field;
+        e.nn = 0;
+        ++n;
+    }
+    h_.dead = static_cast<
+        offset_type>(h_.dead + n);
+    return n;
+}
+
+// mark fields in [i0, i1) matching name
+// as dead without moving the buffer
+std::size_t
+fields_base::
+tombstone_all(
+    std::size_t i0,
+    std::size_t i1,
+    core::string_view name) noexcept
+{
+    ++gen_;
+    std::size_t n = 0;
+    auto const ft = h_.tab();
+    auto const* p = h_.cbuf + h_.prefix;
+    for(auto i = i0; i < i1; ++i)
+    {
+        auto& e = ft[i];
+        if(e.id != detail::header::unknown_field ||
+            ! grammar::ci_is_equal(
+                core::string_view(p + e.np, e.nn), name))
+            continue;
+        e.id = detail::header::dead_field;
+        e.nn = 0;
+        ++n;
+    }
+    h_.dead = static_cast<
+        offset_type>(h_.dead + n);
+    return n;
+}
+
 // return i-th field absolute offset
 std::size_t
 fields_base::
@@ -1498,5 +1768,53 @@ length(
         offset(i);
 }
 
+char*
+fields_base::
+allocate(
+    std::size_t n)
+{
+    if(! mr_)
+        return new char[n];
+    return static_cast<char*>(
+        mr_->allocate(n,
+            alignof(detail::header::entry)));
+}
+
+void
+fields_base::
+deallocate(
+    char* p,
+    std::size_t n) noexcept
+{
+    if(! mr_)
+        return delete[] p;
+    mr_->deallocate(p, n,
+        alignof(detail::header::entry));
+}
+
+// return the capacity to allocate when at
+// least `n` bytes are needed, growing by a
+// factor of 1.5 without exceeding max_cap_
+std::size_t
+fields_base::
+next_capacity(
+    std::size_t n) const noexcept
+{
+    if(n >= max_cap_)
+        return n;
+    // keep the table at the end aligned
+    constexpr std::size_t mask =
+        ~(alignof(detail::header::entry) - 1);
+    auto const cap = h_.cap;
+    if(cap > max_cap_ - cap / 2)
+        return max_cap_ & mask;
+    auto const g = (cap + cap / 2) & mask;
+    if(g <= n)
+        return n;
+    if(g > max_cap_)
+        return max_cap_ & mask;
+    return g;
+}
+
 } // http
 } // boost
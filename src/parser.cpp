@@ -604,6 +604,7 @@ public:
         m_.h_.buf = reinterpret_cast<char*>(ws_.data());
         m_.h_.cbuf = m_.h_.buf;
         m_.h_.cap = ws_.size();
+        ++m_.gen_;
 
         state_ = state::header;
 
@@ -887,6 +888,12 @@ public:
 
             got_header_ = true;
 
+            // find the hot fields once, so
+            // readers of the const message
+            // do not search for them again
+            if(m_.h_.kind == detail::kind::request)
+                m_.hot();
+
             // reserve headers + table
             ws_.reserve_front(m_.h_.size);
             ws_.reserve_back(m_.h_.table_space());
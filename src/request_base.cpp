@@ -11,6 +11,8 @@
 
 #include <boost/http/request_base.hpp>
 
+#include "src/detail/http_date.hpp"
+
 #include <cstring>
 
 namespace boost {
@@ -75,6 +77,76 @@ set_expect_100_continue(bool b)
 
 //------------------------------------------------
 
+void
+request_base::
+find_hot_fields(
+    hot_fields& v) const noexcept
+{
+    v = {};
+    core::string_view ims;
+    core::string_view ius;
+    auto const ft = h_.tab();
+    auto const* p = h_.cbuf + h_.prefix;
+    for(std::size_t i = 0; i < h_.count; ++i)
+    {
+        auto const& e = ft[i];
+        core::string_view const value(
+            p + e.vp, e.vn);
+        // keep the first occurrence, as value_or does
+        auto const first = [&value](
+            core::string_view& s) noexcept
+        {
+            if(s.data() == nullptr)
+                s = value;
+        };
+        switch(e.id)
+        {
+        case field::host:
+            first(v.host);
+            break;
+        case field::range:
+            first(v.range);
+            break;
+        case field::if_range:
+            first(v.if_range);
+            break;
+        case field::accept_encoding:
+            first(v.accept_encoding);
+            break;
+        case field::cookie:
+            first(v.cookie);
+            break;
+        case field::authorization:
+            first(v.authorization);
+            break;
+        case field::if_match:
+            ++v.if_match;
+            break;
+        case field::if_none_match:
+            ++v.if_none_match;
+            break;
+        case field::if_modified_since:
+            first(ims);
+            break;
+        case field::if_unmodified_since:
+            first(ius);
+            break;
+        default:
+            break;
+        }
+    }
+    v.has_if_modified_since =
+        ! ims.empty() &&
+        detail::parse_http_date(
+            ims, v.if_modified_since);
+    v.has_if_unmodified_since =
+        ! ius.empty() &&
+        detail::parse_http_date(
+            ius, v.if_unmodified_since);
+}
+
+//------------------------------------------------
+
 void
 request_base::
 set_start_line_impl(
@@ -31,6 +31,7 @@
 #include <boost/http/zlib/error.hpp>
 #include <boost/http/zlib/flush.hpp>
 
+#include <cstring>
 #include <memory>
 #include <stddef.h>
 
@@ -254,9 +255,15 @@ class serializer::impl
     detail::array_of_const_buffers prepped_;
     capy::const_buffer tmp_;
 
+    // most header buffers sent without copying
+    static constexpr std::uint16_t max_header_bufs = 8;
+
     state state_ = state::start;
     style style_ = style::empty;
     uint8_t chunk_header_len_ = 0;
+    std::uint16_t header_bufs_ = 1;
+    std::size_t header_remain_ = 0;
+    capy::const_buffer header_copy_;
     bool more_input_ = false;
     bool is_chunked_ = false;
     bool needs_exp100_continue_ = false;
@@ -303,7 +310,7 @@ public:
             if(!is_header_done())
                 return const_buffers_type(
                     prepped_.begin(),
-                    1); // limit to header
+                    header_bufs_); // limit to header
 
             needs_exp100_continue_ = false;
 
@@ -463,7 +470,8 @@ public:
             }
         }
 
-        prepped_.reset(!is_header_done());
+        prepped_.reset(
+            is_header_done() ? 0 : header_bufs_);
         for(auto const& cb : out_.data())
         {
             if(cb.size() != 0)
@@ -482,15 +490,22 @@ public:
 
         if(!is_header_done())
         {
-            const auto header_remain =
-                prepped_[0].size();
-            if(n < header_remain)
+            if(n < header_remain_)
             {
+                auto const size0 = prepped_.size();
                 prepped_.consume(n);
+                header_remain_ -= n;
+
+                // keep the unsent header
+                // buffers at the front
+                header_bufs_ = static_cast<std::uint16_t>(
+                    header_bufs_ - (size0 - prepped_.size()));
+                prepped_.slide_to_front();
                 return;
             }
-            n -= header_remain;
-            prepped_.consume(header_remain);
+            n -= header_remain_;
+            prepped_.consume(header_remain_);
+            header_remain_ = 0;
             state_ = state::body;
         }
 
@@ -532,14 +547,20 @@ public:
         // metadata error code failures?
         // m.h_.md.maybe_throw();
 
+        plan_header(m);
+
         auto const& md = m.metadata();
         needs_exp100_continue_ = md.expect.is_100_continue;
 
         // Transfer-Encoding
         is_chunked_ = md.transfer_encoding.is_chunked;
 
-        // Content-Encoding
-        switch (md.content_encoding.coding)
+        // Content-Encoding. A body with a Content-Length
+        // is sent as is, since encoding changes its size;
+        // it may already be encoded, e.g. a precompressed file.
+        switch (md.content_length.count > 0 ?
+            content_coding::identity :
+            md.content_encoding.coding)
         {
         case content_coding::deflate:
             if(!cfg_->apply_deflate_encoder)
@@ -597,7 +618,7 @@ public:
         style_ = style::empty;
 
         prepped_ = make_array(
-            1 + // header
+            header_bufs_ + // header
             2); // out buffer pairs
 
         out_init();
@@ -605,7 +626,7 @@ public:
         if(!filter_)
             out_finish();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        append_header(m);
         more_input_ = false;
     }
 
@@ -624,11 +645,11 @@ public:
             auto batch_size = clamp(stats.count, 16);
 
             prepped_ = make_array(
-                1 + // header
+                header_bufs_ + // header
                 batch_size + // buffers
                 (is_chunked_ ? 2 : 0)); // chunk header + final chunk
 
-            prepped_.append({ m.h_.cbuf, m.h_.size });
+            append_header(m);
             more_input_ = (batch_size != 0);
 
             if(is_chunked_)
@@ -652,12 +673,12 @@ public:
         // filter
 
         prepped_ = make_array(
-            1 + // header
+            header_bufs_ + // header
             2); // out buffer pairs
 
         out_init();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        append_header(m);
         tmp_ = {};
         more_input_ = true;
     }
@@ -669,7 +690,7 @@ public:
         style_ = style::stream;
 
         prepped_ = make_array(
-            1 + // header
+            header_bufs_ + // header
             2); // out buffer pairs
 
         if(filter_)
@@ -681,7 +702,7 @@ public:
 
         out_init();
 
-        prepped_.append({ m.h_.cbuf, m.h_.size });
+        append_header(m);
         more_input_ = true;
     }
 
@@ -747,6 +768,126 @@ private:
         return state_ == state::body;
     }
 
+    // Invoke `f(p, n)` for each run of bytes in the
+    // serialized header of `m`: the start-line and
+    // fields of `m`, followed by the shared fields
+    // of a response. Erased fields awaiting
+    // compaction and shared fields shadowed by a
+    // field of `m` are skipped, so neither the
+    // message nor the block is modified.
+    template<class F>
+    static
+    void
+    for_each_header_run(
+        message_base const& m,
+        F const& f)
+    {
+        auto const emit =
+            [&f](char const* p, std::size_t n)
+            {
+                if(n != 0)
+                    f(p, n);
+            };
+
+        // emit the bytes of `h` up to `last`, less
+        // the entries for which `filter && skip(i)`
+        auto const runs = [&emit](
+            detail::header const& h,
+            std::size_t last,
+            bool filter,
+            auto const& skip)
+        {
+            if(! filter)
+                return emit(h.cbuf, last);
+            std::size_t pos = 0;
+            auto const ft = h.tab();
+            for(std::size_t i = 0; i < h.count; ++i)
+            {
+                if(! skip(i))
+                    continue;
+                std::size_t const p0 =
+                    h.prefix + ft[i].np;
+                std::size_t const p1 = (i + 1 < h.count)
+                    ? h.prefix + ft[i + 1].np
+                    : h.size - 2u;
+                emit(h.cbuf + pos, p0 - pos);
+                pos = p1;
+            }
+            emit(h.cbuf + pos, last - pos);
+        };
+
+        auto const& h = m.h_;
+        auto const* pe = m.ext_;
+        auto const dead = [&h](std::size_t i)
+        {
+            return h.tab()[i].id ==
+                detail::header::dead_field;
+        };
+        if(! pe || pe->count == 0)
+            return runs(h, h.size,
+                h.dead != 0, dead);
+
+        // the shared block supplies the final CRLF
+        runs(h, h.size - 2u, h.dead != 0, dead);
+        runs(*pe, pe->size, h.count != h.dead,
+            [&h, pe](std::size_t i)
+            {
+                return h.shadows(*pe, i);
+            });
+    }
+
+    // Choose how the header of `m` is sent. Each run
+    // of bytes becomes a buffer; when there are too
+    // many, the runs are copied into the workspace.
+    void
+    plan_header(
+        message_base const& m)
+    {
+        std::size_t runs = 0;
+        std::size_t size = 0;
+        for_each_header_run(m,
+            [&](char const*, std::size_t n)
+            {
+                ++runs;
+                size += n;
+            });
+        header_remain_ = size;
+        header_copy_ = {};
+        if(runs <= max_header_bufs)
+        {
+            header_bufs_ = static_cast<
+                std::uint16_t>(runs);
+            return;
+        }
+        auto const dest = ws_.reserve_front(size);
+        std::size_t n = 0;
+        for_each_header_run(m,
+            [&](char const* p, std::size_t len)
+            {
+                std::memcpy(dest + n, p, len);
+                n += len;
+            });
+        header_copy_ = { dest, size };
+        header_bufs_ = 1;
+    }
+
+    // append the buffers chosen by plan_header
+    void
+    append_header(
+        message_base const& m)
+    {
+        if(header_copy_.size() != 0)
+        {
+            prepped_.append(header_copy_);
+            return;
+        }
+        for_each_header_run(m,
+            [&](char const* p, std::size_t n)
+            {
+                prepped_.append({ p, n });
+            });
+    }
+
     detail::array_of_const_buffers
     make_array(std::size_t n)
     {
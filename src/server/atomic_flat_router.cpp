@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/atomic_flat_router.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace boost {
+namespace http {
+
+// One thread's hold on the routes. Only the owning
+// atomic_flat_router keeps a lease alive between
+// dispatches, and only one thread copies it, so its
+// reference count is not shared between threads.
+struct atomic_flat_router::lease
+{
+    std::shared_ptr<flat_router::impl> routes;
+
+    // Set when the thread stops observing the
+    // lease, so that the owner can drop it
+    std::atomic<bool> abandoned{false};
+};
+
+namespace {
+
+// Identifies an atomic_flat_router for the life of
+// the process, as its address may be reused
+std::atomic<std::uint64_t> next_id{1};
+
+// A thread's view of its lease on one object
+struct snapshot_entry
+{
+    std::uint64_t id = 0;
+    std::uint64_t version = 0;
+    std::weak_ptr<void> lease;
+    std::atomic<bool>* abandoned = nullptr;
+
+    // Tell the owner the lease is no longer used.
+    // abandoned is only read while the lease lives.
+    void
+    reset() noexcept
+    {
+        if(auto sp = lease.lock())
+            abandoned->store(true, std::memory_order_relaxed);
+        lease.reset();
+        id = 0;
+    }
+
+    ~snapshot_entry()
+    {
+        reset();
+    }
+};
+
+constexpr std::size_t snapshot_count = 4;
+
+thread_local snapshot_entry snapshots[snapshot_count];
+thread_local std::size_t snapshot_next = 0;
+
+} // (anon)
+
+atomic_flat_router::
+atomic_flat_router(
+    flat_router fr) noexcept
+    : id_(next_id.fetch_add(1, std::memory_order_relaxed))
+    , version_(1)
+    , p_(std::move(fr.impl_))
+{
+}
+
+std::shared_ptr<flat_router::impl>
+atomic_flat_router::
+snapshot() const
+{
+    auto const v = version_.load(std::memory_order_acquire);
+    snapshot_entry* e = nullptr;
+    for(auto& s : snapshots)
+    {
+        if(s.id == id_)
+        {
+            e = &s;
+            break;
+        }
+    }
+    if(e && e->version == v)
+    {
+        auto sp = std::static_pointer_cast<
+            lease>(e->lease.lock());
+        if(sp)
+        {
+            auto const raw = sp->routes.get();
+            return std::shared_ptr<flat_router::impl>(
+                std::move(sp), raw);
+        }
+    }
+
+    if(! e)
+    {
+        e = &snapshots[snapshot_next];
+        snapshot_next = (snapshot_next + 1) % snapshot_count;
+    }
+    e->reset();
+
+    std::shared_ptr<lease> sp;
+    std::vector<std::shared_ptr<lease>> dead;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        // Drop leases which no thread observes
+        auto const it = std::partition(
+            leases_.begin(), leases_.end(),
+            [](std::shared_ptr<lease> const& l)
+            {
+                return ! l->abandoned.load(
+                    std::memory_order_relaxed);
+            });
+        dead.assign(
+            std::make_move_iterator(it),
+            std::make_move_iterator(leases_.end()));
+        leases_.erase(it, leases_.end());
+
+        sp = std::make_shared<lease>();
+        sp->routes = p_;
+        leases_.push_back(sp);
+        e->version = version_.load(std::memory_order_relaxed);
+    }
+    e->id = id_;
+    e->lease = sp;
+    e->abandoned = &sp->abandoned;
+    auto const raw = sp->routes.get();
+    return std::shared_ptr<flat_router::impl>(
+        std::move(sp), raw);
+}
+
+flat_router
+atomic_flat_router::
+load() const
+{
+    return flat_router(snapshot());
+}
+
+void
+atomic_flat_router::
+store(flat_router fr)
+{
+    std::shared_ptr<flat_router::impl> old;
+    std::vector<std::shared_ptr<lease>> leases;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        old = std::move(p_);
+        p_ = std::move(fr.impl_);
+        leases.swap(leases_);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+    // The old routes are released outside the lock,
+    // here unless a dispatch still uses them
+}
+
+route_task
+atomic_flat_router::
+dispatch(
+    http::method verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    return load().dispatch_shared(verb, url, p);
+}
+
+route_task
+atomic_flat_router::
+dispatch(
+    std::string_view verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    return load().dispatch_shared(verb, url, p);
+}
+
+} // http
+} // boost
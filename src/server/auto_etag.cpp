@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/auto_etag.hpp>
+#include <boost/http/server/conditional.hpp>
+#include <boost/http/server/etag.hpp>
+#include <boost/http/field.hpp>
+#include <boost/http/status.hpp>
+
+#include <algorithm>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+etag_body_sink::
+etag_body_sink(
+    route_params& rp,
+    capy::any_buffer_sink& next,
+    std::size_t limit) noexcept
+    : rp_(rp)
+    , next_(next)
+    , limit_(limit)
+{
+}
+
+std::size_t
+etag_body_sink::
+prepare(
+    capy::mutable_buffer* arr,
+    std::size_t max_count)
+{
+    if(direct_)
+        return next_.prepare(arr, max_count);
+    if(max_count == 0)
+        return 0;
+    if(buf_.size() - size_ < 4096)
+        buf_.resize((std::max)(
+            buf_.size() * 2, size_ + 4096));
+    arr[0] = capy::mutable_buffer(
+        &buf_[size_], buf_.size() - size_);
+    return 1;
+}
+
+capy::io_task<>
+etag_body_sink::
+commit(std::size_t n)
+{
+    return commit(n, false);
+}
+
+capy::io_task<>
+etag_body_sink::
+commit(std::size_t n, bool eof)
+{
+    if(direct_)
+        co_return co_await next_.commit(n, eof);
+    size_ += n;
+    if(eof)
+        co_return co_await finish();
+    if(size_ > limit_)
+        co_return co_await spill();
+    co_return {};
+}
+
+capy::io_task<>
+etag_body_sink::
+commit_eof()
+{
+    if(direct_)
+        co_return co_await next_.commit_eof();
+    co_return co_await finish();
+}
+
+capy::io_task<>
+etag_body_sink::
+flush()
+{
+    if(done_ || direct_ || size_ == 0)
+        co_return {};
+    co_return co_await spill();
+}
+
+capy::io_task<>
+etag_body_sink::
+spill()
+{
+    direct_ = true;
+    auto [ec, n] = co_await next_.write(
+        capy::const_buffer(buf_.data(), size_));
+    (void)n;
+    std::string().swap(buf_);
+    co_return {ec};
+}
+
+capy::io_task<>
+etag_body_sink::
+finish()
+{
+    done_ = true;
+    auto& res = rp_.res;
+    core::string_view const body(buf_.data(), size_);
+
+    if(res.status() == status::ok)
+    {
+        if(! res.exists(field::etag))
+            res.set(field::etag, etag(body));
+
+        if(evaluate_preconditions(rp_.req, res) ==
+            precondition_result::not_modified)
+        {
+            res.set_status(status::not_modified);
+            res.erase(field::content_type);
+            res.erase(field::content_length);
+            res.erase(field::transfer_encoding);
+            co_return co_await next_.write_eof();
+        }
+    }
+
+    if( res.status() == status::not_modified ||
+        res.status() == status::no_content)
+        co_return co_await next_.write_eof();
+
+    // The whole body is known, so send its size
+    if(! res.exists(field::content_length))
+        res.set_payload_size(size_);
+
+    auto [ec, n] = co_await next_.write(
+        capy::const_buffer(body.data(), body.size()), true);
+    (void)n;
+    co_return {ec};
+}
+
+} // detail
+} // http
+} // boost
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/conditional.hpp>
+#include <boost/http/field.hpp>
+#include <boost/http/method.hpp>
+
+#include "src/detail/http_date.hpp"
+#include "src/server/detail/conditional.hpp"
+
+namespace boost {
+namespace http {
+
+namespace {
+
+// Parse an entity-tag at the front of s, setting
+// the opaque-tag without its quotes
+bool
+parse_etag(
+    core::string_view& s,
+    core::string_view& tag,
+    bool& weak) noexcept
+{
+    weak = s.starts_with("W/");
+    if(weak)
+        s.remove_prefix(2);
+    if(s.empty() || s[0] != '"')
+        return false;
+    auto const n = s.find('"', 1);
+    if(n == core::string_view::npos)
+        return false;
+    tag = s.substr(1, n - 1);
+    s.remove_prefix(n + 1);
+    return true;
+}
+
+} // (anon)
+
+namespace detail {
+
+bool
+etag_list_match(
+    fields_base::subrange values,
+    core::string_view etag,
+    bool strong) noexcept
+{
+    core::string_view tag;
+    bool weak;
+    bool const valid =
+        parse_etag(etag, tag, weak) && etag.empty();
+
+    for(core::string_view v : values)
+    {
+        // #( entity-tag ), or "*"
+        for(;;)
+        {
+            while(! v.empty() && (
+                v[0] == ' ' || v[0] == '\t' || v[0] == ','))
+                v.remove_prefix(1);
+            if(v.empty())
+                break;
+            if(v[0] == '*')
+                return true;
+            core::string_view t;
+            bool w;
+            if(! parse_etag(v, t, w))
+                break;
+            if( valid && t == tag &&
+                ! (strong && (w || weak)))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool
+not_after(
+    core::string_view date,
+    std::uint64_t limit) noexcept
+{
+    std::uint64_t t;
+    return
+        parse_http_date(date, t) &&
+        t <= limit;
+}
+
+} // detail
+
+bool
+parse_http_date(
+    core::string_view s,
+    std::uint64_t& t) noexcept
+{
+    return detail::parse_http_date(s, t);
+}
+
+precondition_result
+evaluate_preconditions(
+    request const& req,
+    response const& res) noexcept
+{
+    auto const hf = req.hot();
+    auto const etag = res.value_or(field::etag, "");
+    auto const last_modified =
+        res.value_or(field::last_modified, "");
+
+    // If-Match, else If-Unmodified-Since
+    if(hf.if_match > 0)
+    {
+        if(! detail::etag_list_match(
+                req.find_all(field::if_match), etag, true))
+            return precondition_result::precondition_failed;
+    }
+    else if(hf.has_if_unmodified_since)
+    {
+        std::uint64_t lm;
+        if( parse_http_date(last_modified, lm) &&
+            lm > hf.if_unmodified_since)
+            return precondition_result::precondition_failed;
+    }
+
+    bool const safe =
+        req.method() == method::get ||
+        req.method() == method::head;
+
+    // If-None-Match, else If-Modified-Since
+    if(hf.if_none_match > 0)
+    {
+        if(! detail::etag_list_match(
+                req.find_all(field::if_none_match), etag, false))
+            return precondition_result::ok;
+        if(safe)
+            return precondition_result::not_modified;
+        return precondition_result::precondition_failed;
+    }
+
+    if( safe &&
+        hf.has_if_modified_since &&
+        detail::not_after(
+            last_modified, hf.if_modified_since))
+        return precondition_result::not_modified;
+    return precondition_result::ok;
+}
+
+bool
+if_range_matches(
+    request const& req,
+    response const& res) noexcept
+{
+    auto v = req.hot().if_range;
+    if(v.empty())
+        return true;
+
+    // entity-tag, compared strongly
+    if(v[0] == '"' || v.starts_with("W/"))
+    {
+        auto e = res.value_or(field::etag, "");
+        core::string_view t0;
+        core::string_view t1;
+        bool w0;
+        bool w1;
+        return
+            parse_etag(v, t0, w0) && v.empty() &&
+            parse_etag(e, t1, w1) && e.empty() &&
+            ! w0 && ! w1 && t0 == t1;
+    }
+
+    // HTTP-date, which must equal Last-Modified
+    std::uint64_t t;
+    std::uint64_t lm;
+    return
+        parse_http_date(v, t) &&
+        parse_http_date(
+            res.value_or(field::last_modified, ""), lm) &&
+        t == lm;
+}
+
+} // http
+} // boost
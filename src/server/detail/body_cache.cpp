@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include "src/server/detail/body_cache.hpp"
+
+#include <iterator>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+body_cache::
+body_cache(std::size_t budget)
+    : budget_(budget)
+{
+}
+
+auto
+body_cache::
+find(
+    core::string_view path0,
+    std::uint64_t size,
+    std::uint64_t mtime) ->
+        body_type
+{
+    std::string_view const path(path0.data(), path0.size());
+    std::lock_guard<std::mutex> lock(m_);
+    auto it = map_.find(path);
+    if(it == map_.end())
+        return nullptr;
+    auto const li = it->second;
+    if( li->mtime != mtime ||
+        li->body->size() != size)
+    {
+        // The file changed since it was read
+        erase(li);
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, li);
+    return li->body;
+}
+
+void
+body_cache::
+insert(
+    core::string_view path0,
+    std::uint64_t mtime,
+    body_type body)
+{
+    std::string_view const path(path0.data(), path0.size());
+    auto const n = body->size();
+    if(n > budget_)
+        return;
+    std::lock_guard<std::mutex> lock(m_);
+    auto it = map_.find(path);
+    if(it != map_.end())
+        erase(it->second);
+    while(used_ + n > budget_)
+        erase(std::prev(lru_.end()));
+    lru_.push_front(item{
+        std::string(path), mtime, std::move(body) });
+    map_.emplace(lru_.front().path, lru_.begin());
+    used_ += n;
+}
+
+void
+body_cache::
+erase(list_type::iterator it) noexcept
+{
+    used_ -= it->body->size();
+    map_.erase(it->path);
+    lru_.erase(it);
+}
+
+} // detail
+} // http
+} // boost
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_BODY_CACHE_HPP
+#define BOOST_HTTP_SERVER_DETAIL_BODY_CACHE_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Least recently used cache of the contents of small
+// files, bounded by the total size of the contents.
+// Each body is stored with the size and modification
+// time of the file it was read from, and is dropped
+// when a lookup presents different values.
+class body_cache
+{
+public:
+    using body_type = std::shared_ptr<std::string const>;
+
+    explicit
+    body_cache(std::size_t budget);
+
+    // Return the contents of the file at path if they
+    // were read when it had this size and mtime
+    body_type
+    find(
+        core::string_view path,
+        std::uint64_t size,
+        std::uint64_t mtime);
+
+    // Store the contents of the file at path, evicting
+    // the least recently used bodies to stay in budget
+    void
+    insert(
+        core::string_view path,
+        std::uint64_t mtime,
+        body_type body);
+
+private:
+    struct item
+    {
+        std::string path;
+        std::uint64_t mtime;
+        body_type body;
+    };
+
+    using list_type = std::list<item>;
+
+    struct key_hash
+    {
+        std::size_t
+        operator()(std::string_view s) const noexcept
+        {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    void
+    erase(list_type::iterator it) noexcept;
+
+    std::mutex m_;
+    list_type lru_; // most recently used first
+    std::unordered_map<
+        std::string_view, // views item::path
+        list_type::iterator,
+        key_hash> map_;
+    std::size_t budget_;
+    std::size_t used_ = 0;
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_CONDITIONAL_HPP
+#define BOOST_HTTP_SERVER_DETAIL_CONDITIONAL_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/fields_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdint>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Returns true if an entity-tag in the values of an
+// If-Match or If-None-Match field matches etag, or if
+// a value is "*". Weak tags never match a strong
+// comparison.
+bool
+etag_list_match(
+    fields_base::subrange values,
+    core::string_view etag,
+    bool strong) noexcept;
+
+// Returns true if date is a valid HTTP-date
+// which is not later than limit, in seconds
+// since the epoch.
+bool
+not_after(
+    core::string_view date,
+    std::uint64_t limit) noexcept;
+
+} // detail
+} // http
+} // boost
+
+#endif
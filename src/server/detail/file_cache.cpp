@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include "src/server/detail/file_cache.hpp"
+#include <algorithm>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+bool
+file_cache::
+entry::
+acquire(file& f) const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    if(! f_.is_open())
+        return false;
+    f = std::move(f_);
+    return true;
+}
+
+void
+file_cache::
+entry::
+release(file&& f) const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    if(! f_.is_open())
+        f_ = std::move(f);
+}
+
+file_cache::
+file_cache(
+    std::size_t capacity,
+    clock_type::duration ttl)
+    : shards_(std::min(std::max<std::size_t>(
+        capacity / 32, 1), max_shards))
+    , v_(new shard[shards_])
+    , shard_capacity_((capacity + shards_ - 1) / shards_)
+    , ttl_(ttl)
+{
+}
+
+auto
+file_cache::
+get(std::string_view key) const noexcept ->
+    shard&
+{
+    return v_[key_hash{}(key) % shards_];
+}
+
+auto
+file_cache::
+find(core::string_view key0) const ->
+    std::shared_ptr<entry const>
+{
+    std::string_view const key(key0.data(), key0.size());
+    auto& s = get(key);
+    std::lock_guard<std::mutex> lock(s.m);
+    auto it = s.map.find(key);
+    if(it == s.map.end())
+        return nullptr;
+    auto const n = it->second;
+    if(n->e->expires <= clock_type::now())
+    {
+        s.map.erase(it);
+        s.lru.erase(n);
+        return nullptr;
+    }
+    s.lru.splice(s.lru.begin(), s.lru, n);
+    return n->e;
+}
+
+void
+file_cache::
+insert(
+    core::string_view key0,
+    std::shared_ptr<entry> e) const
+{
+    std::string_view const key(key0.data(), key0.size());
+    e->expires = clock_type::now() + ttl_;
+    auto& s = get(key);
+    std::lock_guard<std::mutex> lock(s.m);
+    auto it = s.map.find(key);
+    if(it != s.map.end())
+    {
+        it->second->e = std::move(e);
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+    }
+    if(s.map.size() >= shard_capacity_)
+    {
+        // Requests holding the entry keep it alive
+        auto const& victim = s.lru.back();
+        s.map.erase(std::string_view(victim.key));
+        s.lru.pop_back();
+    }
+    s.lru.push_front(node{ std::string(key), std::move(e) });
+    auto const& k = s.lru.front().key;
+    s.map.emplace(std::string_view(k), s.lru.begin());
+}
+
+} // detail
+} // http
+} // boost
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_FILE_CACHE_HPP
+#define BOOST_HTTP_SERVER_DETAIL_FILE_CACHE_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/file.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Bounded cache of what serve_static learns about a
+// request path from the filesystem: the resolved file,
+// its metadata, the header values derived from it, and
+// an open descriptor. Entries expire after a fixed time,
+// which bounds how long a changed file is served stale.
+//
+// The table is split into shards, each with its own
+// lock, so concurrent requests rarely contend. A full
+// shard evicts its least recently used entry. A small
+// cache has a single shard, so its eviction order is
+// exact.
+//
+// An entry holds one descriptor for its file and one
+// for each precompressed sibling, so the cache keeps
+// at most three descriptors open per entry.
+class file_cache
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct entry
+    {
+        std::string path;           // after index resolution
+        std::string rel;            // path below the root
+        std::string content_type;
+        std::string etag;
+        std::string last_modified;
+        std::uint64_t size = 0;
+        std::uint64_t mtime = 0;
+        clock_type::time_point expires;
+        bool found = false;         // path names a regular file
+        bool is_dir = false;        // the request named a directory
+
+        // precompressed siblings of the file, or null
+        std::shared_ptr<entry const> br;
+        std::shared_ptr<entry const> gz;
+
+        // Move the cached descriptor into f and return
+        // true, or return false if it is in use.
+        bool
+        acquire(file& f) const;
+
+        // Keep f for the next request
+        void
+        release(file&& f) const;
+
+    private:
+        mutable std::mutex m_;
+        mutable file f_;
+    };
+
+    file_cache(
+        std::size_t capacity,
+        clock_type::duration ttl);
+
+    // Return the live entry for key, or nullptr
+    std::shared_ptr<entry const>
+    find(core::string_view key) const;
+
+    // Store e for key, evicting the least recently
+    // used entry if the shard is full.
+    void
+    insert(
+        core::string_view key,
+        std::shared_ptr<entry> e) const;
+
+private:
+    struct key_hash
+    {
+        using is_transparent = void;
+
+        std::size_t
+        operator()(std::string_view s) const noexcept
+        {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    struct node
+    {
+        std::string key;
+        std::shared_ptr<entry const> e;
+    };
+
+    // Nodes in use order, most recent first. The
+    // map keys view the key strings in the nodes.
+    struct alignas(64) shard
+    {
+        std::mutex m;
+        std::list<node> lru;
+        std::unordered_map<
+            std::string_view,
+            std::list<node>::iterator,
+            key_hash,
+            std::equal_to<>> map;
+    };
+
+    static constexpr std::size_t max_shards = 16;
+
+    shard&
+    get(std::string_view key) const noexcept;
+
+    std::size_t shards_;
+    std::unique_ptr<shard[]> v_;
+    std::size_t shard_capacity_;
+    clock_type::duration ttl_;
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
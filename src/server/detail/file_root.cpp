@@ -0,0 +1,297 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include "src/server/detail/file_root.hpp"
+
+#if BOOST_HTTP_USE_POSIX_FILE
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/openat2.h>)
+#include <linux/openat2.h>
+#include <sys/syscall.h>
+#ifdef SYS_openat2
+#define BOOST_HTTP_HAS_OPENAT2
+#endif
+#endif
+#endif
+#else
+#include <chrono>
+#include <filesystem>
+#endif
+
+namespace boost {
+namespace http {
+namespace detail {
+
+namespace {
+
+// Returns true if no segment of rel is "..", and
+// rel holds no NUL which would truncate it
+bool
+is_below(core::string_view rel) noexcept
+{
+    if(rel.find('\0') != core::string_view::npos)
+        return false;
+    while(! rel.empty())
+    {
+#ifdef BOOST_MSVC
+        auto const pos = rel.find_first_of("/\\");
+#else
+        auto const pos = rel.find('/');
+#endif
+        if(rel.substr(0, pos) == "..")
+            return false;
+        rel.remove_prefix(pos == core::string_view::npos ?
+            rel.size() : pos + 1);
+    }
+    return true;
+}
+
+#if BOOST_HTTP_USE_POSIX_FILE
+
+// O_NONBLOCK keeps a FIFO from blocking the
+// open. It has no effect on regular files.
+int constexpr file_flags =
+    O_RDONLY | O_CLOEXEC | O_NONBLOCK;
+
+int
+open_path(int dir, char const* path, int flags) noexcept
+{
+    for(;;)
+    {
+        int const fd = ::openat(dir, path, flags);
+        if(fd != -1 || errno != EINTR)
+            return fd;
+    }
+}
+
+#ifdef BOOST_HTTP_HAS_OPENAT2
+// Set once the kernel turns openat2 away
+std::atomic<bool> no_openat2{false};
+
+int
+open_how_beneath(int dir, char const* path) noexcept
+{
+    ::open_how how{};
+    how.flags = file_flags;
+    how.resolve = RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS;
+    for(;;)
+    {
+        long const fd = ::syscall(
+            SYS_openat2, dir, path, &how, sizeof(how));
+        if(fd != -1)
+            return static_cast<int>(fd);
+        if(errno != EINTR)
+            return -1;
+    }
+}
+#endif
+
+// Open rel below dir, where rel has no ".." segment
+// and no leading '/'. Neither a symbolic link nor a
+// magic link in /proc may resolve outside dir.
+int
+open_beneath(int dir, core::string_view rel)
+{
+    std::string name;
+#ifdef BOOST_HTTP_HAS_OPENAT2
+    if(! no_openat2.load(std::memory_order_relaxed))
+    {
+        name.assign(rel.data(), rel.size());
+        int const fd = open_how_beneath(dir, name.c_str());
+        // Older kernels lack the call, and some
+        // seccomp filters refuse it with EPERM
+        if(fd != -1 || (errno != ENOSYS && errno != EPERM))
+            return fd;
+        no_openat2.store(true, std::memory_order_relaxed);
+    }
+#endif
+    // Walk one segment at a time, since openat
+    // follows links wherever they lead. Every link
+    // is refused, including one which stays below.
+    int dir_flags = O_RDONLY | O_CLOEXEC |
+        O_DIRECTORY | O_NOFOLLOW;
+#ifdef O_PATH
+    // Traversal needs search permission only
+    dir_flags |= O_PATH;
+#endif
+    int fd = dir;
+    for(;;)
+    {
+        auto const pos = rel.find('/');
+        name.assign(rel.data(), pos == core::string_view::npos ?
+            rel.size() : pos);
+        rel.remove_prefix(pos == core::string_view::npos ?
+            rel.size() : pos + 1);
+        while(! rel.empty() && rel.front() == '/')
+            rel.remove_prefix(1);
+        bool const last = rel.empty();
+        int const next = open_path(fd, name.c_str(),
+            last ? file_flags | O_NOFOLLOW : dir_flags);
+        if(fd != dir)
+            ::close(fd);
+        if(next == -1 || last)
+            return next;
+        fd = next;
+    }
+}
+
+// Take ownership of fd and describe it in st
+bool
+adopt(
+    int fd,
+    file& f,
+    file_stat& st)
+{
+    if(fd == -1)
+        return false;
+    f.native_handle(fd);
+
+    struct ::stat sb;
+    if(::fstat(fd, &sb) != 0)
+    {
+        system::error_code ec;
+        f.close(ec);
+        return false;
+    }
+    st.size = static_cast<std::uint64_t>(sb.st_size);
+    st.mtime = static_cast<std::uint64_t>(sb.st_mtime);
+    st.is_dir = S_ISDIR(sb.st_mode);
+    st.is_regular = S_ISREG(sb.st_mode);
+    return true;
+}
+
+#endif
+
+} // (anon)
+
+std::string
+path_cat(
+    core::string_view prefix,
+    core::string_view suffix)
+{
+#ifdef BOOST_MSVC
+    char constexpr path_separator = '\\';
+#else
+    char constexpr path_separator = '/';
+#endif
+    std::string result(prefix);
+    if(! result.empty() && result.back() == path_separator)
+        result.resize(result.size() - 1);
+#ifdef BOOST_MSVC
+    for(auto& c : result)
+        if(c == '/')
+            c = path_separator;
+#endif
+    for(auto const c : suffix)
+        result.push_back(c == '/' ? path_separator : c);
+    return result;
+}
+
+bool
+open_file(
+    file& f,
+    core::string_view path,
+    file_stat& st)
+{
+    st = {};
+    if(path.find('\0') != core::string_view::npos)
+        return false;
+#if BOOST_HTTP_USE_POSIX_FILE
+    std::string const s(path);
+    return adopt(open_path(
+        AT_FDCWD, s.c_str(), file_flags), f, st);
+#else
+    // No portable way to stat a handle,
+    // so the path is examined first
+    system::error_code ec;
+    std::filesystem::path p(path.begin(), path.end());
+    auto const status = std::filesystem::status(p, ec);
+    if(ec.failed())
+        return false;
+    st.is_dir = std::filesystem::is_directory(status);
+    st.is_regular = std::filesystem::is_regular_file(status);
+    if(! st.is_regular)
+        return st.is_dir;
+
+    st.size = static_cast<std::uint64_t>(
+        std::filesystem::file_size(p, ec));
+    if(ec.failed())
+        return false;
+    auto const ftime = std::filesystem::last_write_time(p, ec);
+    if(ec.failed())
+        return false;
+
+    // Convert to Unix timestamp
+    auto const sctp = std::chrono::time_point_cast<
+        std::chrono::system_clock::duration>(
+            ftime - std::filesystem::file_time_type::clock::now() +
+            std::chrono::system_clock::now());
+    st.mtime = static_cast<std::uint64_t>(
+        std::chrono::system_clock::to_time_t(sctp));
+
+    std::string const s(path);
+    f.open(s.c_str(), file_mode::scan, ec);
+    return ! ec.failed();
+#endif
+}
+
+file_root::
+file_root(core::string_view path)
+    : path_(path)
+{
+#if BOOST_HTTP_USE_POSIX_FILE
+    // If the root cannot be opened now, each
+    // file is opened by its full path instead
+    if(! path_.empty())
+        fd_ = ::open(path_.c_str(),
+            O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+file_root::
+~file_root()
+{
+#if BOOST_HTTP_USE_POSIX_FILE
+    if(fd_ != -1)
+        ::close(fd_);
+#endif
+}
+
+bool
+file_root::
+open(
+    file& f,
+    core::string_view rel,
+    file_stat& st) const
+{
+    st = {};
+    if(! is_below(rel))
+        return false;
+#if BOOST_HTTP_USE_POSIX_FILE
+    if(fd_ != -1)
+    {
+        while(! rel.empty() && rel.front() == '/')
+            rel.remove_prefix(1);
+        if(rel.empty())
+            return adopt(open_path(
+                fd_, ".", file_flags), f, st);
+        return adopt(open_beneath(fd_, rel), f, st);
+    }
+#endif
+    return open_file(f, path_cat(path_, rel), st);
+}
+
+} // detail
+} // http
+} // boost
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_FILE_ROOT_HPP
+#define BOOST_HTTP_SERVER_DETAIL_FILE_ROOT_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/file.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// What the filesystem reports about an open file
+struct file_stat
+{
+    std::uint64_t size = 0;
+    std::uint64_t mtime = 0;    // seconds since the epoch
+    bool is_dir = false;
+    bool is_regular = false;
+};
+
+// Open path for reading and fill st from the open
+// descriptor. A directory is opened too, so that
+// st tells the caller what the path names. Returns
+// false if nothing can be opened at path.
+bool
+open_file(
+    file& f,
+    core::string_view path,
+    file_stat& st);
+
+// Append suffix, a '/' separated path, to a local
+// filesystem path, using the native separator
+std::string
+path_cat(
+    core::string_view prefix,
+    core::string_view suffix);
+
+// A directory which files are opened relative to.
+// On POSIX the directory is held open and each file
+// is opened below it, so neither a ".." segment nor
+// a symbolic link can name a file outside the root.
+// Linux 5.6 and later use openat2 with RESOLVE_BENEATH,
+// which follows links that stay below the root. Otherwise
+// the path is walked with O_NOFOLLOW, which refuses
+// every link. Elsewhere, or when the root could not
+// be opened, rel is joined to the root path and only
+// ".." segments are refused.
+class file_root
+{
+    std::string path_;
+#if BOOST_HTTP_USE_POSIX_FILE
+    int fd_ = -1;
+#endif
+
+public:
+    explicit
+    file_root(core::string_view path);
+
+    ~file_root();
+
+    file_root(file_root const&) = delete;
+    file_root& operator=(file_root const&) = delete;
+
+    // The root path, as given
+    std::string const&
+    path() const noexcept
+    {
+        return path_;
+    }
+
+    // Open rel, a '/' separated path below the root,
+    // as open_file does. Returns false if rel has a
+    // ".." segment or a NUL, or would leave the root.
+    bool
+    open(
+        file& f,
+        core::string_view rel,
+        file_stat& st) const;
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
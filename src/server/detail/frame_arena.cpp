@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/detail/frame_arena.hpp>
+#include <boost/capy/ex/frame_allocator.hpp>
+#include <new>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+frame_arena::
+~frame_arena()
+{
+    for(std::size_t i = 0; i < class_count; ++i)
+    {
+        while(auto* p = head_[i])
+        {
+            head_[i] = p->next;
+            ::operator delete(p);
+        }
+    }
+}
+
+frame_arena::
+scope::
+scope(frame_arena& a) noexcept
+    : prev_(capy::get_current_frame_allocator())
+{
+    capy::set_current_frame_allocator(&a);
+}
+
+frame_arena::
+scope::
+~scope()
+{
+    capy::set_current_frame_allocator(prev_);
+}
+
+void*
+frame_arena::
+do_allocate(
+    std::size_t n,
+    std::size_t align)
+{
+    auto const c = n == 0 ? 0 : (n - 1) / granularity;
+    if( c >= class_count ||
+        align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(n, std::align_val_t(align));
+    if(auto* p = head_[c])
+    {
+        head_[c] = p->next;
+        --count_[c];
+        return p;
+    }
+    return ::operator new((c + 1) * granularity);
+}
+
+void
+frame_arena::
+do_deallocate(
+    void* p,
+    std::size_t n,
+    std::size_t align) noexcept
+{
+    auto const c = n == 0 ? 0 : (n - 1) / granularity;
+    if( c >= class_count ||
+        align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        ::operator delete(p, std::align_val_t(align));
+        return;
+    }
+    if(count_[c] >= max_free)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto* node = static_cast<free_node*>(p);
+    node->next = head_[c];
+    head_[c] = node;
+    ++count_[c];
+}
+
+} // detail
+} // http
+} // boost
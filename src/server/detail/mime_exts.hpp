@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_MIME_EXTS_HPP
+#define BOOST_HTTP_SERVER_DETAIL_MIME_EXTS_HPP
+
+#include <boost/core/detail/string_view.hpp>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+struct mime_ext
+{
+    core::string_view ext;
+    core::string_view type;
+};
+
+// The built-in extensions, in lowercase
+inline constexpr mime_ext mime_exts[] = {
+    { "aac", "audio/aac" },
+    { "avif", "image/avif" },
+    { "bmp", "image/bmp" },
+    { "bz", "application/x-bzip" },
+    { "bz2", "application/x-bzip2" },
+    { "cjs", "application/javascript" },
+    { "css", "text/css" },
+    { "csv", "text/csv" },
+    { "flac", "audio/flac" },
+    { "gif", "image/gif" },
+    { "gz", "application/gzip" },
+    { "htm", "text/html" },
+    { "html", "text/html" },
+    { "ico", "image/x-icon" },
+    { "ics", "text/calendar" },
+    { "jpeg", "image/jpeg" },
+    { "jpg", "image/jpeg" },
+    { "js", "text/javascript" },
+    { "json", "application/json" },
+    { "m4a", "audio/mp4" },
+    { "m4v", "video/mp4" },
+    { "manifest", "text/cache-manifest" },
+    { "md", "text/markdown" },
+    { "mjs", "text/javascript" },
+    { "mp3", "audio/mpeg" },
+    { "mp4", "video/mp4" },
+    { "mpeg", "video/mpeg" },
+    { "mpg", "video/mpeg" },
+    { "oga", "audio/ogg" },
+    { "ogg", "audio/ogg" },
+    { "ogv", "video/ogg" },
+    { "otf", "font/otf" },
+    { "pdf", "application/pdf" },
+    { "png", "image/png" },
+    { "rtf", "application/rtf" },
+    { "svg", "image/svg+xml" },
+    { "tar", "application/x-tar" },
+    { "tif", "image/tiff" },
+    { "tiff", "image/tiff" },
+    { "ttf", "font/ttf" },
+    { "txt", "text/plain" },
+    { "wasm", "application/wasm" },
+    { "wav", "audio/wav" },
+    { "weba", "audio/webm" },
+    { "webm", "video/webm" },
+    { "webp", "image/webp" },
+    { "woff", "font/woff" },
+    { "woff2", "font/woff2" },
+    { "xhtml", "application/xhtml+xml" },
+    { "xml", "application/xml" },
+    { "zip", "application/zip" },
+    { "7z", "application/x-7z-compressed" },
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
@@ -8,6 +8,7 @@
 //
 
 #include "src/server/detail/pct_decode.hpp"
+#include <cstring>
 
 namespace boost {
 namespace http {
@@ -99,10 +100,30 @@ pct_decode_path(
     urls::pct_string_view s)
 {
     std::string result;
+    pct_decode_path(s, result);
+    return result;
+}
+
+void
+pct_decode_path(
+    urls::pct_string_view s,
+    std::string& result)
+{
     core::string_view sv(s);
-    result.reserve(s.size());
-    auto it = sv.data();
-    auto const end = it + sv.size();
+    result.clear();
+    // room for the slash appended by dispatch
+    result.reserve(sv.size() + 1);
+    auto it = sv.empty() ? nullptr :
+        static_cast<char const*>(std::memchr(
+            sv.data(), '%', sv.size()));
+    if(! it)
+    {
+        // nothing to decode
+        result.append(sv.data(), sv.size());
+        return;
+    }
+    result.append(sv.data(), it);
+    auto const end = sv.data() + sv.size();
     for(;;)
     {
         if(it == end)
@@ -140,7 +161,6 @@ pct_decode_path(
         }
         result.append(it - 3, 3);
     }
-    return result;
 #if 0
 invalid:
     // can't get here, as received a pct_string_view
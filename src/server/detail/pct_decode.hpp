@@ -35,6 +35,13 @@ std::string
 pct_decode_path(
     urls::pct_string_view s);
 
+// decode into result, reusing its capacity. One
+// extra byte is reserved for a trailing slash.
+void
+pct_decode_path(
+    urls::pct_string_view s,
+    std::string& result);
+
 } // detail
 } // http
 } // boost
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include "src/server/detail/route_index.hpp"
+#include <boost/url/grammar/ci_string.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+namespace grammar = urls::grammar;
+
+route_index::
+route_index()
+    : nodes_(1)
+{
+}
+
+std::size_t
+route_index::
+find_child(
+    std::size_t n,
+    char ch) const noexcept
+{
+    for(auto c : nodes_[n].children)
+        if(nodes_[c].label[0] == ch)
+            return c;
+    return 0;
+}
+
+void
+route_index::
+insert(
+    core::string_view prefix,
+    std::size_t idx)
+{
+    std::string key;
+    key.reserve(prefix.size());
+    for(char ch : prefix)
+        key.push_back(grammar::to_lower(ch));
+
+    core::string_view s = key;
+    std::size_t n = 0;
+    for(;;)
+    {
+        if(s.empty())
+        {
+            nodes_[n].matchers.push_back(idx);
+            return;
+        }
+        auto const c = find_child(n, s[0]);
+        if(c == 0)
+        {
+            node nd;
+            nd.label = std::string(s);
+            nd.matchers.push_back(idx);
+            nodes_.push_back(std::move(nd));
+            nodes_[n].children.push_back(
+                nodes_.size() - 1);
+            return;
+        }
+
+        // length of the common prefix
+        std::size_t k = 1;
+        {
+            auto const& label = nodes_[c].label;
+            while( k < label.size() &&
+                k < s.size() &&
+                label[k] == s[k])
+                ++k;
+        }
+        if(k < nodes_[c].label.size())
+        {
+            // split the edge at k
+            node tail;
+            tail.label = nodes_[c].label.substr(k);
+            tail.children = std::move(nodes_[c].children);
+            tail.matchers = std::move(nodes_[c].matchers);
+            nodes_[c].label.resize(k);
+            nodes_[c].children.clear();
+            nodes_[c].matchers.clear();
+            nodes_.push_back(std::move(tail));
+            nodes_[c].children.push_back(
+                nodes_.size() - 1);
+        }
+        s.remove_prefix(k);
+        n = c;
+    }
+}
+
+void
+route_index::
+propagate(std::size_t n)
+{
+    // every matcher reachable at n is also
+    // a candidate in each of its children
+    for(auto c : nodes_[n].children)
+    {
+        auto& up = nodes_[n].matchers;
+        auto& own = nodes_[c].matchers;
+        std::vector<std::size_t> v;
+        v.reserve(up.size() + own.size());
+        std::merge(
+            up.begin(), up.end(),
+            own.begin(), own.end(),
+            std::back_inserter(v));
+        own = std::move(v);
+        propagate(c);
+    }
+}
+
+void
+route_index::
+finish()
+{
+    propagate(0);
+}
+
+std::vector<std::size_t> const&
+route_index::
+find(core::string_view path) const noexcept
+{
+    auto it = path.data();
+    auto const end = it + path.size();
+    std::size_t n = 0;
+    while(it != end)
+    {
+        auto const c = find_child(n, *it);
+        if(c == 0)
+            break;
+        auto const& label = nodes_[c].label;
+        if(label.size() > static_cast<
+                std::size_t>(end - it))
+            break;
+        std::size_t k = 1;
+        while( k < label.size() &&
+            it[k] == label[k])
+            ++k;
+        if(k < label.size())
+            break;
+        it += k;
+        n = c;
+    }
+    return nodes_[n].matchers;
+}
+
+} // detail
+} // http
+} // boost
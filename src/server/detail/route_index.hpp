@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_ROUTE_INDEX_HPP
+#define BOOST_HTTP_SERVER_DETAIL_ROUTE_INDEX_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Compressed radix tree over the literal prefixes
+// of the root matchers in a flat_router.
+//
+// Keys are stored lowercase so a single tree serves
+// both case-sensitive and insensitive matchers; the
+// lookup returns a superset of the matchers which can
+// match, and each candidate is still tested exactly.
+class route_index
+{
+    struct node
+    {
+        std::string label;                  // edge from parent
+        std::vector<std::size_t> children;  // node indices
+        std::vector<std::size_t> matchers;  // sorted matcher indices
+    };
+
+    std::vector<node> nodes_;
+
+    std::size_t
+    find_child(
+        std::size_t n,
+        char ch) const noexcept;
+
+    void
+    propagate(std::size_t n);
+
+public:
+    route_index();
+
+    // Add the root matcher at `idx` whose pattern
+    // begins with the literal `prefix`. An empty
+    // prefix makes it a candidate for every path.
+    // Must be called in increasing order of `idx`.
+    void
+    insert(
+        core::string_view prefix,
+        std::size_t idx);
+
+    // Called once, after the last insert
+    void
+    finish();
+
+    // Return the sorted indices of the root matchers
+    // whose literal prefix is a prefix of `path`, which
+    // must already be lowercase.
+    std::vector<std::size_t> const&
+    find(core::string_view path) const noexcept;
+};
+
+} // detail
+} // http
+} // boost
+
+#endif
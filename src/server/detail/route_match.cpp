@@ -9,6 +9,7 @@
 
 #include "src/server/detail/pct_decode.hpp"
 #include "src/server/detail/route_match.hpp"
+#include <cstring>
 
 namespace boost {
 namespace http {
@@ -28,6 +29,16 @@ matcher(
                 s.pop_back();
             return s;
         }())
+    , lower_pat_(
+        [this]
+        {
+            std::string s(
+                decoded_pat_.data(),
+                decoded_pat_.size());
+            for(auto& c : s)
+                c = grammar::to_lower(c);
+            return s;
+        }())
     , end_(end_arg)
     , slash_(pat == "/")
 {
@@ -36,6 +47,151 @@ matcher(
             decoded_pat_, detail::path_rule).value();
 }
 
+namespace {
+
+// Matches the segments of a pattern against a path,
+// capturing parameters into the params of the request.
+struct seg_matcher
+{
+    static constexpr std::size_t npos =
+        static_cast<std::size_t>(-1);
+
+    char const* cmp;        // path, lowercase if case-insensitive
+    char const* val;        // path, as decoded
+    std::size_t size;
+    char const* pat;        // pattern, lowercase if case-insensitive
+    char const* pat0;       // decoded pattern
+    route_seg const* segs;
+    std::size_t nsegs;
+    bool end;
+    route_params_base& p;
+
+    // Work left before the match is abandoned. Each
+    // attempt to match the rest of the pattern, and
+    // each character scanned by a parameter, costs
+    // one step. Several multi-segment parameters
+    // could otherwise backtrack in polynomial time
+    // with an exponent of their number.
+    std::size_t budget;
+
+    // Steps allowed per character of the path
+    static constexpr std::size_t steps_per_char = 16;
+
+    bool
+    spend(std::size_t n) noexcept
+    {
+        if(budget < n)
+        {
+            budget = 0;
+            return false;
+        }
+        budget -= n;
+        return true;
+    }
+
+    core::string_view
+    prefix(route_seg const& sg) const noexcept
+    {
+        return { pat + (sg.prefix.data() - pat0),
+            sg.prefix.size() };
+    }
+
+    bool
+    literal(
+        std::size_t pos,
+        core::string_view s) const noexcept
+    {
+        return s.size() <= size - pos && (
+            s.empty() || std::memcmp(
+                cmp + pos, s.data(), s.size()) == 0);
+    }
+
+    // Match segs[k..] at pos. Returns the
+    // end of the match, or npos on failure.
+    std::size_t
+    match(
+        std::size_t k,
+        std::size_t pos)
+    {
+        if(! spend(1))
+            return npos;
+        if(k == nsegs)
+            return (! end || pos == size) ? pos : npos;
+        auto const& sg = segs[k];
+        auto const pre = prefix(sg);
+        if(sg.ptype == 0)
+        {
+            if(! literal(pos, pre))
+                return npos;
+            return match(k + 1, pos + pre.size());
+        }
+        if(literal(pos, pre))
+        {
+            auto const r = capture(k, pos + pre.size());
+            if(r != npos)
+                return r;
+        }
+        // An optional parameter may be omitted
+        // together with the slash before it
+        if( (sg.modifier == '?' || sg.modifier == '*') &&
+            ! pre.empty() && pre.back() == '/' &&
+            literal(pos, pre.substr(0, pre.size() - 1)))
+            return match(k + 1, pos + pre.size() - 1);
+        return npos;
+    }
+
+    // Match the parameter segs[k] starting at pos,
+    // longest first, then the rest of the pattern.
+    std::size_t
+    capture(
+        std::size_t k,
+        std::size_t pos)
+    {
+        auto const& sg = segs[k];
+        auto const& cc = sg.cc;
+        bool const multi =
+            sg.ptype == '*' ||
+            sg.modifier == '+' ||
+            sg.modifier == '*';
+        std::size_t min = cc.min;
+        if(sg.modifier == '?' || sg.modifier == '*')
+            min = 0;
+        auto limit = size;
+        if(cc.max != char_constraint::unbounded &&
+                size - pos > cc.max)
+            limit = pos + cc.max;
+
+        auto e = pos;
+        while(e < limit && (val[e] == '/' ?
+            multi : cc.contains(val[e])))
+            ++e;
+        if(! spend(e - pos))
+            return npos;
+
+        auto const n0 = p.nparams_;
+        for(;;)
+        {
+            if(e - pos < min)
+                return npos;
+            if(n0 < route_params_base::max_params)
+            {
+                p.params_[n0] = { sg.name,
+                    core::string_view(val + pos, e - pos) };
+                p.nparams_ = n0 + 1;
+            }
+            auto const r = match(k + 1, e);
+            if(r != npos)
+                return r;
+            p.nparams_ = n0;
+            if(e == pos || budget == 0)
+                return npos;
+            --e;
+        }
+    }
+};
+
+} // (anon)
+
 bool
 router_base::
 matcher::
@@ -52,44 +208,31 @@ operator()(
         mr.adjust_path(p, 0);
         return true;
     }
-    auto it = p.path.data();
-    auto pit = pv_.segs.begin();
-    auto const path_end = it + p.path.size();
-    auto const pend = pv_.segs.end();
-    while(it != path_end && pit != pend)
+    // Case-insensitive matching compares the lowercase
+    // copy of the path with the lowercase pattern, at
+    // the same offsets. Captured values always come
+    // from the decoded path.
+    auto const val = p.path.data();
+    auto cmp = val;
+    auto pat = decoded_pat_.data();
+    if(! p.case_sensitive)
     {
-        // prefix has to match
-        auto s = core::string_view(it, path_end);
-        if(! p.case_sensitive)
-        {
-            if(pit->prefix.size() > s.size())
-                return false;
-            s = s.substr(0, pit->prefix.size());
-            //if(! grammar::ci_is_equal(s, pit->prefix))
-            if(! ci_is_equal(s, pit->prefix))
-                return false;
-        }
-        else
-        {
-            if(! s.starts_with(pit->prefix))
-                return false;
-        }
-        it += pit->prefix.size();
-        ++pit;
+        BOOST_ASSERT(
+            p.lowered_path_.size() ==
+            p.decoded_path_.size());
+        cmp = p.lowered_path_.data() +
+            (val - p.decoded_path_.data());
+        pat = lower_pat_.data();
     }
-    if(end_)
-    {
-        // require full match
-        if( it != path_end ||
-            pit != pend)
-            return false;
-    }
-    else if(pit != pend)
-    {
+    seg_matcher sm{
+        cmp, val, p.path.size(),
+        pat, decoded_pat_.data(),
+        pv_.segs.data(), pv_.segs.size(),
+        end_, p,
+        seg_matcher::steps_per_char * (p.path.size() + 1) };
+    auto const n = sm.match(0, 0);
+    if(n == seg_matcher::npos)
         return false;
-    }
-    // number of matching characters
-    auto const n = it - p.path.data();
     mr.adjust_path(p, n);
     return true;
 }
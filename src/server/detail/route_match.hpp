@@ -38,10 +38,13 @@ private:
 
     // 16 bytes (pointer + size)
     stable_string decoded_pat_;
+    stable_string lower_pat_;       // decoded_pat_ in lowercase
 
     // 8 bytes each
     std::size_t first_entry_ = 0;   // flat_router: first entry using this matcher
     std::size_t skip_ = 0;          // flat_router: entry index to jump to on failure
+    std::size_t parent_ = 0;        // flat_router: enclosing matcher (depth_ > 0)
+    std::uint64_t methods_ = 0;     // flat_router: method bits of the entries in scope
 
     // 4 bytes each
     opt_flags effective_opts_ = 0;  // flat_router: computed opts for this scope
@@ -16,6 +16,8 @@
 #include <boost/url/grammar/alpha_chars.hpp>
 #include <boost/url/grammar/charset.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 #include "src/server/detail/stable_string.hpp"
@@ -179,6 +181,198 @@ constexpr struct
 
 //------------------------------------------------
 
+/** A compiled parameter constraint
+
+    Constraints use a subset of regular expression
+    syntax which compiles to a set of allowed
+    characters and a range of lengths:
+
+    @code
+    constraint  = atom [ quantifier ]
+    atom        = "\d" / "\w" / "." / "[" [ "^" ] 1*range "]"
+    range       = "\d" / "\w" / char [ "-" char ]
+    quantifier  = "?" / "*" / "+" / "{" n [ "," [ m ] ] "}"
+    @endcode
+*/
+struct char_constraint
+{
+    static constexpr std::uint32_t unbounded =
+        (std::numeric_limits<std::uint32_t>::max)();
+
+    std::uint64_t bits[4] = { ~0ull, ~0ull, ~0ull, ~0ull };
+    std::uint32_t min = 1;
+    std::uint32_t max = unbounded;
+
+    bool
+    contains(char ch) const noexcept
+    {
+        auto const c = static_cast<unsigned char>(ch);
+        return (bits[c >> 6] >> (c & 63)) & 1;
+    }
+
+    void
+    set(unsigned char lo, unsigned char hi) noexcept
+    {
+        for(unsigned c = lo; c <= hi; ++c)
+            bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+    }
+
+    void
+    set_digit() noexcept
+    {
+        set('0', '9');
+    }
+
+    void
+    set_word() noexcept
+    {
+        set('0', '9');
+        set('A', 'Z');
+        set('a', 'z');
+        set('_', '_');
+    }
+};
+
+// Compile the text between the parentheses
+// of a constraint, which must not be empty.
+inline
+system::result<char_constraint>
+compile_constraint(core::string_view s) noexcept
+{
+    char_constraint cc;
+    for(auto& b : cc.bits)
+        b = 0;
+    auto it = s.data();
+    auto const end = it + s.size();
+
+    // atom
+    if(*it == '\\')
+    {
+        if(++it == end)
+            BOOST_HTTP_RETURN_EC(
+                grammar::error::invalid);
+        if(*it == 'd')
+            cc.set_digit();
+        else if(*it == 'w')
+            cc.set_word();
+        else
+            BOOST_HTTP_RETURN_EC(
+                grammar::error::invalid);
+        ++it;
+    }
+    else if(*it == '.')
+    {
+        cc.set(0, 255);
+        ++it;
+    }
+    else if(*it == '[')
+    {
+        ++it;
+        bool negate = false;
+        if(it != end && *it == '^')
+        {
+            negate = true;
+            ++it;
+        }
+        auto const first = it;
+        while(it != end && (*it != ']' || it == first))
+        {
+            if(*it == '\\')
+            {
+                if(++it == end)
+                    BOOST_HTTP_RETURN_EC(
+                        grammar::error::invalid);
+                if(*it == 'd')
+                    cc.set_digit();
+                else if(*it == 'w')
+                    cc.set_word();
+                else
+                    cc.set(*it, *it);
+                ++it;
+                continue;
+            }
+            unsigned char const lo = *it++;
+            unsigned char hi = lo;
+            if( it != end && *it == '-' &&
+                it + 1 != end && it[1] != ']')
+            {
+                hi = it[1];
+                it += 2;
+                if(hi < lo)
+                    BOOST_HTTP_RETURN_EC(
+                        grammar::error::invalid);
+            }
+            cc.set(lo, hi);
+        }
+        if(it == end)
+            BOOST_HTTP_RETURN_EC(
+                grammar::error::invalid);
+        ++it; // ']'
+        if(negate)
+            for(auto& b : cc.bits)
+                b = ~b;
+    }
+    else
+    {
+        BOOST_HTTP_RETURN_EC(
+            grammar::error::invalid);
+    }
+
+    // quantifier
+    cc.min = 1;
+    cc.max = 1;
+    if(it != end)
+    {
+        switch(*it++)
+        {
+        case '?': cc.min = 0; break;
+        case '*': cc.min = 0; cc.max = char_constraint::unbounded; break;
+        case '+': cc.max = char_constraint::unbounded; break;
+        case '{':
+        {
+            auto const number = [&](std::uint32_t& v)
+            {
+                if(it == end || *it < '0' || *it > '9')
+                    return false;
+                v = 0;
+                while(it != end && *it >= '0' && *it <= '9')
+                {
+                    if(v > 100000)
+                        return false;
+                    v = v * 10 + (*it++ - '0');
+                }
+                return true;
+            };
+            if(! number(cc.min))
+                BOOST_HTTP_RETURN_EC(
+                    grammar::error::invalid);
+            cc.max = cc.min;
+            if(it != end && *it == ',')
+            {
+                ++it;
+                cc.max = char_constraint::unbounded;
+                if(it != end && *it != '}')
+                    if(! number(cc.max))
+                        BOOST_HTTP_RETURN_EC(
+                            grammar::error::invalid);
+            }
+            if( it == end || *it++ != '}' ||
+                cc.max < cc.min)
+                BOOST_HTTP_RETURN_EC(
+                    grammar::error::invalid);
+            break;
+        }
+        default:
+            BOOST_HTTP_RETURN_EC(
+                grammar::error::invalid);
+        }
+    }
+    if(it != end)
+        BOOST_HTTP_RETURN_EC(
+            grammar::error::invalid);
+    return cc;
+}
+
 /** A unit of matching in a route pattern
 */
 struct route_seg
@@ -187,7 +381,8 @@ struct route_seg
     core::string_view prefix;
     core::string_view name;
     core::string_view constraint;
-    char ptype = 0; // ':' | '?' | NULL
+    char_constraint cc;     // compiled constraint
+    char ptype = 0; // ':' | '*' | NULL
     char modifier = 0;
 };
 
@@ -224,6 +419,13 @@ struct param_segment_rule_t
             if( rv.has_error())
                 return rv.error();
             v.constraint = rv.value();
+            if(! v.constraint.empty())
+            {
+                auto rv2 = compile_constraint(v.constraint);
+                if(rv2.has_error())
+                    return rv2.error();
+                v.cc = rv2.value();
+            }
         }
         // modifier
         if( it != end && (
@@ -256,7 +458,7 @@ struct path_rule_t
     {
         value_type rv;
         auto it = it0;
-        auto it1 = it;
+        auto it1 = it; // start of the literal text
         while(it != end)
         {
             if( *it == ':' ||
@@ -264,12 +466,11 @@ struct path_rule_t
             {
                 auto const it2 = it;
                 auto rv1 = urls::grammar::parse(
-                    core::string_view(it, end),
-                    param_segment_rule);
+                    it, end, param_segment_rule);
                 if(rv1.has_error())
                     return rv1.error();
                 route_seg rs = rv1.value();
-                rs.prefix = { it2, it1 };
+                rs.prefix = core::string_view(it1, it2);
                 rv.segs.push_back(rs);
                 it1 = it;
                 continue;
@@ -282,7 +483,7 @@ struct path_rule_t
             rs.prefix = core::string_view(it1, end);
             rv.segs.push_back(rs);
         }
-        it0 = it0 + (it - it1);
+        it0 = it;
         // gcc 7 bug workaround
         return system::result<value_type>(std::move(rv));
     }
@@ -0,0 +1,36 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_SERVER_DETAIL_SEND_FILE_HPP
+#define BOOST_HTTP_SERVER_DETAIL_SEND_FILE_HPP
+
+#include <boost/http/detail/config.hpp>
+#include <boost/http/server/send_file.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http {
+namespace detail {
+
+// Prepare the response for a file whose size, mtime,
+// content_type, and when enabled in opts, etag and
+// last_modified are already set in info. This is
+// send_file_init without the filesystem access.
+void
+send_file_prepare(
+    send_file_info& info,
+    route_params& rp,
+    send_file_options const& opts);
+
+} // detail
+} // http
+} // boost
+
+#endif
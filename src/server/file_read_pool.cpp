@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/file_read_pool.hpp>
+#include <boost/assert.hpp>
+
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+struct file_read_pool::impl
+{
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<std::thread> threads;
+    std::size_t max_threads;
+    std::size_t idle = 0;
+    pooled_file_reader* head = nullptr;
+    pooled_file_reader* tail = nullptr;
+    bool stop = false;
+
+    explicit
+    impl(std::size_t n) noexcept
+        : max_threads(n > 0 ? n : 1)
+    {
+    }
+
+    void
+    work() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m);
+        for(;;)
+        {
+            ++idle;
+            cv.wait(lock, [this]
+            {
+                return stop || head != nullptr;
+            });
+            --idle;
+            if(! head)
+                return;
+            auto r = head;
+            head = r->next_;
+            if(! head)
+                tail = nullptr;
+            r->next_ = nullptr;
+            lock.unlock();
+            r->run();
+            lock.lock();
+        }
+    }
+};
+
+file_read_pool::
+~file_read_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(impl_->m);
+        impl_->stop = true;
+    }
+    impl_->cv.notify_all();
+    for(auto& t : impl_->threads)
+        t.join();
+    BOOST_ASSERT(impl_->head == nullptr);
+    delete impl_;
+}
+
+file_read_pool::
+file_read_pool(std::size_t max_threads)
+    : impl_(new impl(max_threads))
+{
+}
+
+std::size_t
+file_read_pool::
+max_threads() const noexcept
+{
+    return impl_->max_threads;
+}
+
+void
+file_read_pool::
+submit(pooled_file_reader& r)
+{
+    {
+        std::lock_guard<std::mutex> lock(impl_->m);
+
+        // start a thread when none is free
+        if( impl_->idle == 0 &&
+            impl_->threads.size() < impl_->max_threads)
+            impl_->threads.emplace_back(
+                [this]{ impl_->work(); });
+
+        if(impl_->tail)
+            impl_->tail->next_ = &r;
+        else
+            impl_->head = &r;
+        impl_->tail = &r;
+    }
+    impl_->cv.notify_one();
+}
+
+//------------------------------------------------
+
+// Suspends the caller until the pool thread
+// finishes, unless it already has
+struct pooled_file_reader::wait_op
+{
+    pooled_file_reader& r;
+
+    bool
+    await_ready() const noexcept
+    {
+        return r.state_.load(
+            std::memory_order_acquire) != state::pending;
+    }
+
+    capy::coro
+    await_suspend(
+        capy::coro h,
+        capy::executor_ref ex,
+        std::stop_token) noexcept
+    {
+        r.h_ = h;
+        r.ex_ = ex;
+        auto expected = state::pending;
+        if(r.state_.compare_exchange_strong(
+                expected, state::waiting,
+                std::memory_order_acq_rel))
+            return std::noop_coroutine();
+        // completed in the meantime
+        return h;
+    }
+
+    void
+    await_resume() const noexcept
+    {
+    }
+};
+
+pooled_file_reader::
+~pooled_file_reader()
+{
+    // the pool thread must be done with us
+    while(state_.load(
+            std::memory_order_acquire) == state::pending)
+        std::this_thread::yield();
+}
+
+pooled_file_reader::
+pooled_file_reader(
+    file_read_pool& pool) noexcept
+    : pool_(pool)
+{
+}
+
+void
+pooled_file_reader::
+start_read(
+    file& f,
+    std::uint64_t offset,
+    capy::mutable_buffer b)
+{
+    BOOST_ASSERT(state_.load() != state::pending);
+    BOOST_ASSERT(state_.load() != state::waiting);
+    f_ = &f;
+    offset_ = offset;
+    b_ = b;
+    ec_ = {};
+    n_ = 0;
+    state_.store(state::pending, std::memory_order_release);
+    try
+    {
+        pool_.submit(*this);
+    }
+    catch(...)
+    {
+        state_.store(state::idle, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+capy::io_task<std::size_t>
+pooled_file_reader::
+wait_read()
+{
+    co_await wait_op{ *this };
+    state_.store(state::idle, std::memory_order_relaxed);
+    co_return { ec_, n_ };
+}
+
+// called on a thread of the pool
+void
+pooled_file_reader::
+run() noexcept
+{
+    f_->seek(offset_, ec_);
+    if(! ec_.failed() && b_.size() > 0)
+        n_ = f_->read(b_.data(), b_.size(), ec_);
+
+    // Once the read is seen as done the reader may be
+    // reused or destroyed, so the waiter is copied out
+    auto const prev = state_.exchange(
+        state::done, std::memory_order_acq_rel);
+    if(prev == state::waiting)
+    {
+        auto const ex = ex_;
+        ex.post(h_);
+    }
+}
+
+} // http
+} // boost
@@ -13,8 +13,17 @@
 
 #include "src/server/detail/router_base.hpp"
 #include "src/server/detail/pct_decode.hpp"
+#include "src/server/detail/route_index.hpp"
 #include "src/server/detail/route_match.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
 namespace boost {
 namespace http {
 
@@ -33,6 +42,21 @@ struct flat_router::impl
     std::vector<entry> entries;
     std::vector<matcher> matchers;
 
+    // Create the handler's coroutine with its frame
+    // drawn from the arena of the route parameters
+    static
+    route_task
+    invoke(
+        handler const& h,
+        route_params_base& p)
+    {
+        detail::frame_arena::scope s(p.frames_);
+        return h.invoke(p);
+    }
+
+    // root matchers by literal prefix
+    detail::route_index index;
+
     // RAII scope tracker sets matcher's skip_ when scope ends
     struct scope_tracker
     {
@@ -78,17 +102,91 @@ struct flat_router::impl
         return result;
     }
 
+    // Returns the literal text which every path
+    // matched by m must begin with, or an empty
+    // string if m can match any path.
+    static core::string_view
+    literal_prefix(matcher const& m) noexcept
+    {
+        if( m.slash_ ||
+            m.pv_.segs.empty())
+            return {};
+        auto const& sg = m.pv_.segs.front();
+        auto s = sg.prefix;
+        // an optional parameter may drop the slash before it
+        if( (sg.modifier == '?' || sg.modifier == '*') &&
+            ! s.empty() && s.back() == '/')
+            s.remove_suffix(1);
+        return s;
+    }
+
+    static_assert(static_cast<unsigned>(
+        http::method::unlink) < 63);
+
+    // The bit for a method in a method mask.
+    // Custom verbs share the highest bit.
+    static std::uint64_t
+    method_bit(
+        http::method verb) noexcept
+    {
+        if(verb == http::method::unknown)
+            return std::uint64_t(1) << 63;
+        return std::uint64_t(1) <<
+            static_cast<unsigned>(verb);
+    }
+
+    // The methods for which entry e can be invoked
+    static std::uint64_t
+    entry_methods(
+        entry const& e,
+        matcher const& m) noexcept
+    {
+        // middleware runs for every method
+        if(! m.end_ || e.all)
+            return ~std::uint64_t(0);
+        return method_bit(e.verb);
+    }
+
     void
     flatten(detail::router_base::impl& src)
     {
-        flatten_recursive(src, opt_flags{}, 0);
+        flatten_recursive(src, opt_flags{}, 0, 0);
+
+        // Each scope's mask is the union of the
+        // masks of the entries within it.
+        for(auto const& e : entries)
+        {
+            auto const bits = entry_methods(
+                e, matchers[e.matcher_idx]);
+            for(std::size_t k = e.matcher_idx;; k = matchers[k].parent_)
+            {
+                matchers[k].methods_ |= bits;
+                if(matchers[k].depth_ == 0)
+                    break;
+            }
+        }
+
+        // Index the root matchers. Every entry lies in
+        // the scope of exactly one root matcher, so the
+        // scopes of the candidates returned by the index
+        // are the only entry ranges dispatch must visit.
+        for(std::size_t k = 0; k < matchers.size(); ++k)
+        {
+            auto const& m = matchers[k];
+            if( m.depth_ != 0 ||
+                m.first_entry_ == m.skip_)
+                continue;
+            index.insert(literal_prefix(m), k);
+        }
+        index.finish();
     }
 
     void
     flatten_recursive(
         detail::router_base::impl& src,
         opt_flags parent_opts,
-        std::uint32_t depth)
+        std::uint32_t depth,
+        std::size_t parent)
     {
         opt_flags eff = compute_effective_opts(parent_opts, src.opt);
 
@@ -101,6 +199,7 @@ struct flat_router::impl
             m.first_entry_ = entries.size();
             m.effective_opts_ = eff;
             m.depth_ = depth;
+            m.parent_ = parent;
             // m.skip_ set by scope_tracker dtor
 
             scope_tracker scope(matchers, entries, matcher_idx);
@@ -112,7 +211,8 @@ struct flat_router::impl
                     // Recurse into nested router
                     auto* nested = e.h->get_router();
                     if(nested && nested->impl_)
-                        flatten_recursive(*nested->impl_, eff, depth + 1);
+                        flatten_recursive(
+                            *nested->impl_, eff, depth + 1, matcher_idx);
                 }
                 else
                 {
@@ -142,107 +242,313 @@ struct flat_router::impl
                 p.decoded_path_.size() - 1, 1 };  // soft slash
     }
 
-    route_task
-    dispatch_loop(route_params_base& p) const
+    // The lowercase copy of p.path
+    static core::string_view
+    lowered(route_params_base const& p) noexcept
     {
-        // All checks happen BEFORE co_await to minimize coroutine launches.
-        // Avoid touching p.ep_ (expensive atomic on Windows) - use p.kind_ for mode checks.
+        return { p.lowered_path_.data() +
+            (p.path.data() - p.decoded_path_.data()),
+            p.path.size() };
+    }
+
+    //--------------------------------------------------
+    //
+    // Instrumentation
+    //
+    //--------------------------------------------------
+
+    using clock_type = std::chrono::steady_clock;
+
+    // Counters for each entry, one set per shard. A thread
+    // always updates the same shard, and every set of
+    // counters starts on its own cache line.
+    struct stats_table
+    {
+        struct alignas(64) counters
+        {
+            std::atomic<std::uint64_t> calls;
+            std::atomic<std::uint64_t> outcomes[6];
+            std::atomic<std::uint64_t> latency[route_stats::buckets];
+        };
+
+        std::size_t shards;
+        std::size_t size;
+        std::unique_ptr<counters[]> v;
+
+        stats_table(
+            std::size_t shards_,
+            std::size_t size_)
+            : shards(shards_)
+            , size(size_)
+            , v(new counters[shards_ * size_]())
+        {
+        }
+
+        counters&
+        local(std::size_t i) const noexcept
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local std::size_t const id =
+                next.fetch_add(1, std::memory_order_relaxed);
+            return v[(id % shards) * size + i];
+        }
+    };
+
+    std::unique_ptr<stats_table> stats;
 
+    // outcome is a route_what, or 5 for an exception
+    void
+    record(
+        std::size_t i,
+        std::size_t outcome,
+        clock_type::time_point t0) const noexcept
+    {
+        auto const ns = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(
+                clock_type::now() - t0).count();
+        std::size_t k = 0;
+        if(ns > 0)
+            k = std::bit_width(
+                static_cast<std::uint64_t>(ns)) - 1;
+        if(k >= route_stats::buckets)
+            k = route_stats::buckets - 1;
+
+        auto& c = stats->local(i);
+        c.calls.fetch_add(1, std::memory_order_relaxed);
+        c.outcomes[outcome].fetch_add(1, std::memory_order_relaxed);
+        c.latency[k].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The full pattern for entries using matcher k
+    std::string
+    pattern_of(std::size_t k) const
+    {
+        std::size_t chain[detail::router_base::max_path_depth];
+        std::size_t n = 0;
+        for(;; k = matchers[k].parent_)
+        {
+            chain[n++] = k;
+            if(matchers[k].depth_ == 0)
+                break;
+        }
+        std::string s;
+        while(n-- > 0)
+        {
+            auto const& m = matchers[chain[n]];
+            if(! m.slash_)
+                s.append(
+                    m.decoded_pat_.data(),
+                    m.decoded_pat_.size());
+        }
+        if(s.empty())
+            s = "/";
+        return s;
+    }
+
+    //--------------------------------------------------
+
+    // Matcher state carried from one entry to the next
+    struct match_state
+    {
         std::size_t last_matched = SIZE_MAX;
         std::uint32_t current_depth = 0;
 
         // Stack of base_path lengths at each depth level.
         // path_stack[d] = base_path.size() before any matcher at depth d was tried.
         std::size_t path_stack[detail::router_base::max_path_depth];
-        path_stack[0] = 0;
+
+        // param_stack[d] = number of captured params before depth d.
+        std::size_t param_stack[detail::router_base::max_path_depth];
 
         // Track which matcher index is matched at each depth level.
         // matched_at_depth[d] = matcher index that successfully matched at depth d.
         std::size_t matched_at_depth[detail::router_base::max_path_depth];
-        for(std::size_t d = 0; d < detail::router_base::max_path_depth; ++d)
-            matched_at_depth[d] = SIZE_MAX;
 
-        for(std::size_t i = 0; i < entries.size(); )
+        match_state() noexcept
         {
-            auto const& e = entries[i];
-            auto const& m = matchers[e.matcher_idx];
-            auto const target_depth = m.depth_;
+            path_stack[0] = 0;
+            param_stack[0] = 0;
+            for(std::size_t d = 0; d < detail::router_base::max_path_depth; ++d)
+                matched_at_depth[d] = SIZE_MAX;
+        }
+    };
 
-            //--------------------------------------------------
-            // Pre-invoke checks (no coroutine yet)
-            //--------------------------------------------------
+    // Returns the first entry at or after i lying in the
+    // scope of a candidate root matcher, or entries.size().
+    // Entries outside those scopes would fail at the root
+    // matcher (or be skipped in error mode), so they are
+    // jumped over without calling any matcher.
+    std::size_t
+    next_candidate(
+        std::vector<std::size_t> const& cand,
+        std::size_t& ci,
+        std::size_t i) const noexcept
+    {
+        while( ci < cand.size() &&
+                matchers[cand[ci]].skip_ <= i)
+            ++ci;
+        if(ci == cand.size())
+            return entries.size();
+        if(i < matchers[cand[ci]].first_entry_)
+            return matchers[cand[ci]].first_entry_;
+        return i;
+    }
+
+    // Returns the end of the outermost scope enclosing
+    // entry i which has no entry for the method, or i.
+    // Such a scope holds only end routes for other
+    // methods, which cannot run in any dispatch mode.
+    std::size_t
+    skip_method(
+        std::size_t i,
+        std::uint64_t bit) const noexcept
+    {
+        // enclosing scopes are supersets
+        auto k = entries[i].matcher_idx;
+        if(matchers[k].methods_ & bit)
+            return i;
+        for(;; k = matchers[k].parent_)
+        {
+            if(! (matchers[k].methods_ & bit))
+                i = matchers[k].skip_;
+            if(matchers[k].depth_ == 0)
+                break;
+        }
+        return i;
+    }
+
+    // Match the matchers enclosing entry i, outermost
+    // first. Ancestors matched for an earlier entry stay
+    // matched; the entry's own matcher is re-tested unless
+    // it was the last one to match. On failure, sets i to
+    // the next entry to try and returns false.
+    bool
+    match_entry(
+        route_params_base& p,
+        match_state& st,
+        std::size_t& i) const
+    {
+        auto const& e = entries[i];
+
+        // Collect the entry's matcher and its enclosing
+        // matchers, innermost first.
+        std::size_t chain[detail::router_base::max_path_depth];
+        std::size_t n = 0;
+        for(std::size_t k = e.matcher_idx;; k = matchers[k].parent_)
+        {
+            chain[n++] = k;
+            if(matchers[k].depth_ == 0)
+                break;
+        }
+
+        while(n-- > 0)
+        {
+            auto const check_idx = chain[n];
+            auto const& cm = matchers[check_idx];
 
-            // For nested routes: verify ancestors at depths 0..target_depth-1 are matched.
-            // For siblings: if moving to same depth with different matcher, restore path.
-            bool ancestors_ok = true;
-            
-            // Check if we need to match new ancestor matchers for this entry.
-            // We iterate through matchers from last_matched+1 to e.matcher_idx,
-            // but ONLY process those that are at depths we need (ancestors or self).
-            std::size_t start_idx = (last_matched == SIZE_MAX) ? 0 : last_matched + 1;
-            
-            for(std::size_t check_idx = start_idx;
-                check_idx <= e.matcher_idx && ancestors_ok;
-                ++check_idx)
+            if(n > 0)
             {
-                auto const& cm = matchers[check_idx];
-                
-                // Only check matchers that are:
-                // 1. Ancestors (depth < target_depth) that we haven't matched yet, or
-                // 2. The entry's own matcher
-                bool is_needed_ancestor = (cm.depth_ < target_depth) && 
-                    (matched_at_depth[cm.depth_] == SIZE_MAX);
-                bool is_self = (check_idx == e.matcher_idx);
-                
-                if(!is_needed_ancestor && !is_self)
+                if(st.matched_at_depth[cm.depth_] == check_idx)
                     continue;
+            }
+            else if(st.last_matched == check_idx)
+            {
+                continue;
+            }
 
-                // Restore path if moving to same or shallower depth
-                if(cm.depth_ <= current_depth && current_depth > 0)
-                {
-                    restore_path(p, path_stack[cm.depth_]);
-                }
+            // Restore path if moving to same or shallower depth
+            if(cm.depth_ <= st.current_depth && st.current_depth > 0)
+            {
+                restore_path(p, st.path_stack[cm.depth_]);
+                p.nparams_ = st.param_stack[cm.depth_];
+            }
 
-                // In error/exception mode, skip end routes
-                if(cm.end_ && p.kind_ != detail::router_base::is_plain)
-                {
-                    i = cm.skip_;
-                    ancestors_ok = false;
-                    break;
-                }
+            // In error/exception mode, skip end routes
+            if(cm.end_ && p.kind_ != detail::router_base::is_plain)
+            {
+                i = cm.skip_;
+                return false;
+            }
 
-                // Apply effective_opts for this matcher
-                p.case_sensitive = (cm.effective_opts_ & 2) != 0;
-                p.strict = (cm.effective_opts_ & 8) != 0;
+            // Apply effective_opts for this matcher
+            p.case_sensitive = (cm.effective_opts_ & 2) != 0;
+            p.strict = (cm.effective_opts_ & 8) != 0;
 
-                // Save path state before trying this matcher
-                if(cm.depth_ < detail::router_base::max_path_depth)
-                    path_stack[cm.depth_] = p.base_path.size();
+            // Save path state before trying this matcher
+            if(cm.depth_ < detail::router_base::max_path_depth)
+            {
+                st.path_stack[cm.depth_] = p.base_path.size();
+                st.param_stack[cm.depth_] = p.nparams_;
+            }
 
-                match_result mr;
-                if(!cm(p, mr))
-                {
-                    // Clear matched_at_depth for this depth and deeper
-                    for(std::size_t d = cm.depth_; d < detail::router_base::max_path_depth; ++d)
-                        matched_at_depth[d] = SIZE_MAX;
-                    i = cm.skip_;
-                    ancestors_ok = false;
-                    break;
-                }
+            match_result mr;
+            if(!cm(p, mr))
+            {
+                // Clear matched_at_depth for this depth and deeper
+                for(std::size_t d = cm.depth_; d < detail::router_base::max_path_depth; ++d)
+                    st.matched_at_depth[d] = SIZE_MAX;
+                i = cm.skip_;
+                return false;
+            }
+
+            // Mark this depth as matched
+            if(cm.depth_ < detail::router_base::max_path_depth)
+                st.matched_at_depth[cm.depth_] = check_idx;
+
+            st.last_matched = check_idx;
+            st.current_depth = cm.depth_ + 1;
+
+            // Save state for next depth level
+            if(st.current_depth < detail::router_base::max_path_depth)
+            {
+                st.path_stack[st.current_depth] = p.base_path.size();
+                st.param_stack[st.current_depth] = p.nparams_;
+            }
+        }
+        return true;
+    }
+
+    // The last parameter, when set, keeps this object
+    // alive for the duration of the dispatch.
+    route_task
+    dispatch_loop(
+        route_params_base& p,
+        std::size_t i0 = 0,
+        std::shared_ptr<impl const> = {}) const
+    {
+        // All checks happen BEFORE co_await to minimize coroutine launches.
+        // Avoid touching p.ep_ (expensive atomic on Windows) - use p.kind_ for mode checks.
+
+        match_state st;
 
-                // Mark this depth as matched
-                if(cm.depth_ < detail::router_base::max_path_depth)
-                    matched_at_depth[cm.depth_] = check_idx;
-                
-                last_matched = check_idx;
-                current_depth = cm.depth_ + 1;
+        // Root matchers which can match this path, in order
+        restore_path(p, 0);
+        p.nparams_ = 0;
+        auto const& cand = index.find(lowered(p));
+        std::size_t ci = 0;
+        auto const bit = method_bit(p.verb_);
 
-                // Save state for next depth level
-                if(current_depth < detail::router_base::max_path_depth)
-                    path_stack[current_depth] = p.base_path.size();
+        for(std::size_t i = i0;;)
+        {
+            i = next_candidate(cand, ci, i);
+            if(i == entries.size())
+                break;
+
+            // Skip scopes with no route for the method
+            if(auto const j = skip_method(i, bit); j != i)
+            {
+                i = j;
+                continue;
             }
 
-            if(!ancestors_ok)
+            auto const& e = entries[i];
+            auto const& m = matchers[e.matcher_idx];
+
+            //--------------------------------------------------
+            // Pre-invoke checks (no coroutine yet)
+            //--------------------------------------------------
+
+            if(! match_entry(p, st, i))
                 continue;
 
             // Check method match (only for end routes)
@@ -264,20 +570,31 @@ struct flat_router::impl
             // Invoke handler (coroutine starts here)
             //--------------------------------------------------
 
+            auto const t0 = stats ?
+                clock_type::now() : clock_type::time_point();
             route_result rv;
             try
             {
-                rv = co_await e.h->invoke(
-                    const_cast<route_params_base&>(p));
+                if(e.h->sync)
+                    rv = e.h->invoke_sync(
+                        const_cast<route_params_base&>(p));
+                else
+                    rv = co_await invoke(*e.h,
+                        const_cast<route_params_base&>(p));
             }
             catch(...)
             {
+                if(stats)
+                    record(i, 5, t0);
                 // Only touch ep_ when actually catching
                 p.ep_ = std::current_exception();
                 p.kind_ = detail::router_base::is_exception;
                 ++i;
                 continue;
             }
+            if(stats)
+                record(i, static_cast<
+                    std::size_t>(rv.what()), t0);
 
             //--------------------------------------------------
             // Handle result
@@ -335,6 +652,387 @@ struct flat_router::impl
 
         co_return route_next;  // no handler matched
     }
+
+    // The union of the methods of the routes whose
+    // pattern matches the path in p. Only end route
+    // scopes are visited, and the index is used as
+    // in dispatch.
+    std::string
+    allowed(route_params_base& p) const
+    {
+        std::uint64_t mask = 0;
+        std::vector<std::string_view> custom;
+
+        // end routes are skipped outside plain mode
+        auto const kind = p.kind_;
+        p.kind_ = detail::router_base::is_plain;
+        match_state st;
+        restore_path(p, 0);
+        p.nparams_ = 0;
+        auto const& cand = index.find(lowered(p));
+        std::size_t ci = 0;
+        for(std::size_t i = 0;;)
+        {
+            i = next_candidate(cand, ci, i);
+            if(i == entries.size())
+                break;
+            auto const& m = matchers[entries[i].matcher_idx];
+            if(! m.end_)
+            {
+                ++i;
+                continue;
+            }
+            if(! match_entry(p, st, i))
+                continue;
+            mask |= m.methods_;
+            if(m.methods_ & method_bit(http::method::unknown))
+            {
+                for(auto j = i; j < m.skip_; ++j)
+                {
+                    auto const& e = entries[j];
+                    if( ! e.all &&
+                        e.verb == http::method::unknown &&
+                        std::find(custom.begin(), custom.end(),
+                            std::string_view(e.verb_str)) ==
+                                custom.end())
+                        custom.push_back(e.verb_str);
+                }
+            }
+            i = m.skip_;
+        }
+        p.kind_ = kind;
+
+        std::string s;
+        auto const last = static_cast<unsigned>(
+            http::method::unlink);
+        for(unsigned b = 1; b <= last; ++b)
+        {
+            if(! (mask & (std::uint64_t(1) << b)))
+                continue;
+            auto const sv = http::to_string(
+                static_cast<http::method>(b));
+            if(! s.empty())
+                s.append(", ");
+            s.append(sv.data(), sv.size());
+        }
+        for(auto const& sv : custom)
+        {
+            if(! s.empty())
+                s.append(", ");
+            s.append(sv.data(), sv.size());
+        }
+        return s;
+    }
+
+    //--------------------------------------------------
+    //
+    // Hot route cache
+    //
+    //--------------------------------------------------
+
+    // The plain-mode handlers which a request with a
+    // given method and path reaches, and the base_path
+    // length and params each one sees. Handler results do not
+    // affect which matchers succeed, so this is fixed
+    // for the lifetime of the router.
+    struct plan
+    {
+        struct step
+        {
+            std::size_t entry;      // index into entries
+            std::size_t base_len;   // base_path size for the handler
+            std::size_t param0;     // first of the handler's params
+            std::size_t param1;     // one past the last
+        };
+
+        // a captured param, as an offset into the path
+        struct param
+        {
+            core::string_view name;
+            std::size_t pos;
+            std::size_t size;
+        };
+
+        http::method verb;
+        std::string path;
+        std::vector<step> steps;
+        std::vector<param> params;
+    };
+
+    // Bounded, lock-free table of plans. A slot is filled
+    // once and never replaced, so readers need no
+    // reclamation scheme; plans live as long as this impl.
+    // A rebuilt router has its own impl, and an empty cache.
+    //
+    // Since slots are never freed, a key is admitted only
+    // on its second miss: each miss records the key's hash
+    // in a doorkeeper slot, and a key is cached once it
+    // finds its own hash there. Paths seen once, such as
+    // scans for nonexistent files, do not take slots.
+    class hot_cache
+    {
+        static constexpr std::size_t probes = 4;
+
+        std::unique_ptr<std::atomic<plan const*>[]> slots_;
+        std::unique_ptr<std::atomic<std::size_t>[]> seen_;
+        std::size_t size_ = 0;
+
+    public:
+        ~hot_cache()
+        {
+            for(std::size_t k = 0; k < size_; ++k)
+                delete slots_[k].load(std::memory_order_relaxed);
+        }
+
+        void
+        init(std::size_t n)
+        {
+            slots_.reset(new std::atomic<plan const*>[n]);
+            seen_.reset(new std::atomic<std::size_t>[n]);
+            for(std::size_t k = 0; k < n; ++k)
+            {
+                slots_[k].store(nullptr, std::memory_order_relaxed);
+                seen_[k].store(0, std::memory_order_relaxed);
+            }
+            size_ = n;
+        }
+
+        bool
+        enabled() const noexcept
+        {
+            return size_ != 0;
+        }
+
+        static std::size_t
+        hash(
+            http::method verb,
+            core::string_view path) noexcept
+        {
+            std::size_t h = std::hash<std::string_view>{}(
+                std::string_view(path.data(), path.size()));
+            h ^= static_cast<std::size_t>(verb) +
+                0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+
+        // Returns the plan for the key, or nullptr. Sets
+        // full to true if no slot is left for the key.
+        plan const*
+        find(
+            std::size_t h,
+            http::method verb,
+            core::string_view path,
+            bool& full) const noexcept
+        {
+            full = true;
+            for(std::size_t k = 0; k < probes; ++k)
+            {
+                auto const pl = slots_[(h + k) % size_].load(
+                    std::memory_order_acquire);
+                if(! pl)
+                {
+                    full = false;
+                    return nullptr;
+                }
+                if(pl->verb == verb && pl->path == path)
+                    return pl;
+            }
+            return nullptr;
+        }
+
+        // Returns true if the key with hash h missed
+        // before, else remembers it and returns false.
+        // Races only delay or hasten an admission.
+        bool
+        admit(std::size_t h) noexcept
+        {
+            auto& seen = seen_[h % size_];
+            if(seen.load(std::memory_order_relaxed) == h)
+                return true;
+            seen.store(h, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Returns the cached plan for the key of pl,
+        // which is pl itself unless another thread got
+        // there first, or nullptr if the slots are taken.
+        plan const*
+        insert(
+            std::size_t h,
+            std::unique_ptr<plan> pl) noexcept
+        {
+            for(std::size_t k = 0; k < probes; ++k)
+            {
+                plan const* expected = nullptr;
+                auto& slot = slots_[(h + k) % size_];
+                if(slot.compare_exchange_strong(
+                    expected, pl.get(),
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+                    return pl.release();
+                if( expected->verb == pl->verb &&
+                    expected->path == pl->path)
+                    return expected;
+            }
+            return nullptr;
+        }
+    };
+
+    hot_cache cache;
+
+    // Resolve the plan for the request in p
+    std::unique_ptr<plan>
+    make_plan(route_params_base& p) const
+    {
+        auto pl = std::make_unique<plan>();
+        pl->verb = p.verb_;
+        pl->path = p.path;
+
+        match_state st;
+        restore_path(p, 0);
+        p.nparams_ = 0;
+        auto const& cand = index.find(lowered(p));
+        std::size_t ci = 0;
+        auto const bit = method_bit(p.verb_);
+        for(std::size_t i = 0;;)
+        {
+            i = next_candidate(cand, ci, i);
+            if(i == entries.size())
+                break;
+            if(auto const j = skip_method(i, bit); j != i)
+            {
+                i = j;
+                continue;
+            }
+            auto const& e = entries[i];
+            auto const& m = matchers[e.matcher_idx];
+            if(! match_entry(p, st, i))
+                continue;
+            if( e.h->kind == detail::router_base::is_plain &&
+                (! m.end_ || e.match_method(p)))
+            {
+                auto const param0 = pl->params.size();
+                for(std::size_t k = 0; k < p.nparams_; ++k)
+                    pl->params.push_back({
+                        p.params_[k].name,
+                        static_cast<std::size_t>(
+                            p.params_[k].value.data() -
+                            p.decoded_path_.data()),
+                        p.params_[k].value.size() });
+                pl->steps.push_back({ i, p.base_path.size(),
+                    param0, pl->params.size() });
+            }
+            ++i;
+        }
+        return pl;
+    }
+
+    // Invoke the handlers of a cached plan. Leaving plain
+    // mode hands off to dispatch_loop at the next entry.
+    route_task
+    dispatch_plan(
+        route_params_base& p,
+        plan const& pl,
+        std::shared_ptr<impl const>) const
+    {
+        std::size_t skip = 0;
+        std::size_t resume = SIZE_MAX;
+        for(auto const& s : pl.steps)
+        {
+            if(s.entry < skip)
+                continue;
+
+            auto const& e = entries[s.entry];
+            auto const& m = matchers[e.matcher_idx];
+            p.case_sensitive = (m.effective_opts_ & 2) != 0;
+            p.strict = (m.effective_opts_ & 8) != 0;
+            restore_path(p, s.base_len);
+            p.nparams_ = 0;
+            for(auto k = s.param0; k < s.param1; ++k)
+            {
+                auto const& pp = pl.params[k];
+                p.params_[p.nparams_++] = { pp.name,
+                    core::string_view(
+                        p.decoded_path_.data() + pp.pos,
+                        pp.size) };
+            }
+
+            auto const t0 = stats ?
+                clock_type::now() : clock_type::time_point();
+            route_result rv;
+            try
+            {
+                if(e.h->sync)
+                    rv = e.h->invoke_sync(p);
+                else
+                    rv = co_await invoke(*e.h, p);
+            }
+            catch(...)
+            {
+                if(stats)
+                    record(s.entry, 5, t0);
+                p.ep_ = std::current_exception();
+                p.kind_ = detail::router_base::is_exception;
+                resume = s.entry + 1;
+                break;
+            }
+            if(stats)
+                record(s.entry, static_cast<
+                    std::size_t>(rv.what()), t0);
+
+            if(rv.what() == route_what::next)
+                continue;
+
+            if(rv.what() == route_what::next_route)
+            {
+                if(!m.end_)
+                    co_return route_error(error::invalid_route_result);
+                skip = m.skip_;
+                continue;
+            }
+
+            if(rv.what() == route_what::done ||
+               rv.what() == route_what::close)
+                co_return rv;
+
+            p.ec_ = rv.error();
+            p.kind_ = detail::router_base::is_error;
+            resume = m.end_ ? m.skip_ : s.entry + 1;
+            break;
+        }
+
+        if(resume != SIZE_MAX)
+            co_return co_await dispatch_loop(p, resume);
+
+        co_return route_next;  // no handler matched
+    }
+
+    route_task
+    dispatch(
+        route_params_base& p,
+        std::shared_ptr<impl const> hold) const
+    {
+        // Custom methods are not cached
+        if( ! cache.enabled() ||
+            p.verb_ == http::method::unknown)
+            return dispatch_loop(p, 0, std::move(hold));
+
+        // The key is the path as requested; decoded_path_
+        // has a slash appended, so "/a" and "/a/" would
+        // share it, yet a strict router tells them apart.
+        auto const h = hot_cache::hash(p.verb_, p.path);
+        bool full;
+        auto pl = cache.find(h, p.verb_, p.path, full);
+        if(! pl)
+        {
+            if(full || ! cache.admit(h))
+                return dispatch_loop(p, 0, std::move(hold));
+            pl = cache.insert(h, make_plan(p));
+            if(! pl)
+                return dispatch_loop(p, 0, std::move(hold));
+        }
+        return dispatch_plan(p, *pl, std::move(hold));
+    }
 };
 
 //------------------------------------------------
@@ -347,26 +1045,32 @@ flat_router(
     impl_->flatten(*src.impl_);
 }
 
-route_task
 flat_router::
-dispatch(
-    http::method verb,
-    urls::url_view const& url,
-    route_params_base& p) const
+flat_router(
+    detail::router_base&& src,
+    std::size_t cache_size)
+    : flat_router(std::move(src))
 {
-    if(verb == http::method::unknown)
-        detail::throw_invalid_argument();
+    if(cache_size > 0)
+        impl_->cache.init(cache_size);
+}
 
-    // Initialize params
+namespace {
+
+void
+prepare_path(
+    urls::url_view const& url,
+    route_params_base& p)
+{
     p.kind_ = detail::router_base::is_plain;
-    p.verb_ = verb;
-    p.verb_str_.clear();
     p.ec_.clear();
     p.ep_ = nullptr;
-    p.decoded_path_ = detail::pct_decode_path(url.encoded_path());
-    p.base_path = { p.decoded_path_.data(), 0 };
-    p.path = p.decoded_path_;
-    if(p.decoded_path_.back() != '/')
+    p.nparams_ = 0;
+    // Decode into the existing capacity, which
+    // already has room for the trailing slash.
+    detail::pct_decode_path(url.encoded_path(), p.decoded_path_);
+    if( p.decoded_path_.empty() ||
+        p.decoded_path_.back() != '/')
     {
         p.decoded_path_.push_back('/');
         p.addedSlash_ = true;
@@ -375,45 +1079,152 @@ dispatch(
     {
         p.addedSlash_ = false;
     }
+    // Fold case once for every case-insensitive matcher
+    p.lowered_path_.resize(p.decoded_path_.size());
+    for(std::size_t i = 0; i < p.decoded_path_.size(); ++i)
+        p.lowered_path_[i] = urls::grammar::to_lower(p.decoded_path_[i]);
+    p.base_path = { p.decoded_path_.data(), 0 };
+    p.path = { p.decoded_path_.data(),
+        p.decoded_path_.size() - (p.addedSlash_ ? 1 : 0) };
+}
 
-    return impl_->dispatch_loop(p);
+// Initialize params
+void
+prepare(
+    http::method verb,
+    urls::url_view const& url,
+    route_params_base& p)
+{
+    if(verb == http::method::unknown)
+        detail::throw_invalid_argument();
+
+    p.verb_ = verb;
+    p.verb_str_.clear();
+    prepare_path(url, p);
 }
 
-route_task
-flat_router::
-dispatch(
+// Initialize params
+void
+prepare(
     std::string_view verb,
     urls::url_view const& url,
-    route_params_base& p) const
+    route_params_base& p)
 {
     if(verb.empty())
         detail::throw_invalid_argument();
 
-    // Initialize params
-    p.kind_ = detail::router_base::is_plain;
     p.verb_ = http::string_to_method(verb);
     if(p.verb_ == http::method::unknown)
         p.verb_str_ = verb;
     else
         p.verb_str_.clear();
-    p.ec_.clear();
-    p.ep_ = nullptr;
-    p.decoded_path_ = detail::pct_decode_path(url.encoded_path());
-    p.base_path = { p.decoded_path_.data(), 0 };
-    p.path = p.decoded_path_;
-    if(p.decoded_path_.back() != '/')
-    {
-        p.decoded_path_.push_back('/');
-        p.addedSlash_ = true;
-    }
-    else
+    prepare_path(url, p);
+}
+
+} // (anon)
+
+void
+flat_router::
+enable_stats(std::size_t shards)
+{
+    if(shards == 0)
+        shards = std::thread::hardware_concurrency();
+    if(shards == 0)
+        shards = 1;
+    impl_->stats = std::make_unique<impl::stats_table>(
+        shards, impl_->entries.size());
+}
+
+std::vector<route_stats>
+flat_router::
+stats() const
+{
+    std::vector<route_stats> v;
+    auto const* t = impl_->stats.get();
+    if(! t)
+        return v;
+    v.resize(t->size);
+    for(std::size_t i = 0; i < t->size; ++i)
     {
-        p.addedSlash_ = false;
+        auto& rs = v[i];
+        auto const& e = impl_->entries[i];
+        rs.pattern = impl_->pattern_of(e.matcher_idx);
+        if(! e.all)
+        {
+            if(e.verb != http::method::unknown)
+            {
+                auto const sv = http::to_string(e.verb);
+                rs.method.assign(sv.data(), sv.size());
+            }
+            else
+                rs.method = e.verb_str;
+        }
+        for(std::size_t j = 0; j < t->shards; ++j)
+        {
+            auto const& c = t->v[j * t->size + i];
+            rs.calls += c.calls.load(std::memory_order_relaxed);
+            for(std::size_t k = 0; k < 6; ++k)
+                rs.outcomes[k] += c.outcomes[k].load(
+                    std::memory_order_relaxed);
+            for(std::size_t k = 0; k < route_stats::buckets; ++k)
+                rs.latency[k] += c.latency[k].load(
+                    std::memory_order_relaxed);
+        }
     }
+    return v;
+}
 
-    return impl_->dispatch_loop(p);
+std::string
+flat_router::
+allowed_methods(
+    route_params_base& p) const
+{
+    return impl_->allowed(p);
+}
+
+route_task
+flat_router::
+dispatch(
+    http::method verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    prepare(verb, url, p);
+    return impl_->dispatch(p, nullptr);
+}
+
+route_task
+flat_router::
+dispatch(
+    std::string_view verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    prepare(verb, url, p);
+    return impl_->dispatch(p, nullptr);
+}
+
+route_task
+flat_router::
+dispatch_shared(
+    http::method verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    prepare(verb, url, p);
+    return impl_->dispatch(p, impl_);
+}
+
+route_task
+flat_router::
+dispatch_shared(
+    std::string_view verb,
+    urls::url_view const& url,
+    route_params_base& p) const
+{
+    prepare(verb, url, p);
+    return impl_->dispatch(p, impl_);
 }
 
 } // http
 } // boost
-
@@ -0,0 +1,420 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/server/mime_map.hpp>
+#include <boost/http/detail/except.hpp>
+#include <boost/http/file.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/value.hpp>
+
+#include "src/server/detail/mime_exts.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+namespace {
+
+// Longer extensions are not stored
+constexpr std::size_t max_ext = 32;
+
+char
+ascii_lower(char c) noexcept
+{
+    if(c >= 'A' && c <= 'Z')
+        return static_cast<char>(c + ('a' - 'A'));
+    return c;
+}
+
+std::uint64_t
+hash_ext(
+    core::string_view s,
+    std::uint64_t seed) noexcept
+{
+    std::uint64_t h = 14695981039346656037ULL ^
+        (seed * 0x9e3779b97f4a7c15ULL);
+    for(unsigned char c : s)
+    {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= seed * 0xc2b2ae3d27d4eb4fULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+struct slot
+{
+    core::string_view ext; // empty if unused
+    mime_type_entry entry;
+};
+
+// Hash and displace: each extension hashes to a
+// bucket, and each bucket stores the seed of the
+// hash which places all of its extensions in free
+// slots. A lookup reads the seed, then one slot.
+struct table
+{
+    std::string strings;
+    std::vector<slot> slots;
+    std::vector<std::uint32_t> disp;
+    std::size_t mask = 0;
+    std::size_t count = 0;
+
+    mime_type_entry const*
+    find(core::string_view s) const noexcept
+    {
+        auto const sep = s.find_last_of("/\\");
+        if(sep != core::string_view::npos)
+            s.remove_prefix(sep + 1);
+        auto const dot = s.rfind('.');
+        if(dot != core::string_view::npos)
+            s.remove_prefix(dot + 1);
+        if(s.empty() || s.size() > max_ext)
+            return nullptr;
+
+        char buf[max_ext];
+        for(std::size_t i = 0; i < s.size(); ++i)
+            buf[i] = ascii_lower(s[i]);
+        core::string_view const key(buf, s.size());
+
+        auto const b = hash_ext(key, 0) % disp.size();
+        auto const& sl = slots[hash_ext(key, disp[b]) & mask];
+        if(sl.ext != key)
+            return nullptr;
+        return &sl.entry;
+    }
+};
+
+class builder
+{
+    struct record
+    {
+        std::string ext;
+        std::string type;
+        std::string charset;
+        bool compressible;
+    };
+
+    std::vector<record> v_;
+    std::unordered_map<std::string, std::size_t> index_;
+
+    static
+    bool
+    place(
+        table& t,
+        std::vector<slot> const& items,
+        std::size_t cap)
+    {
+        std::size_t const nb = items.size() / 4 + 1;
+        t.slots.assign(cap, slot{});
+        t.mask = cap - 1;
+        t.disp.assign(nb, 0);
+
+        std::vector<std::vector<std::size_t>> buckets(nb);
+        for(std::size_t i = 0; i < items.size(); ++i)
+            buckets[hash_ext(items[i].ext, 0) % nb].push_back(i);
+
+        // Place the largest buckets first
+        std::vector<std::size_t> order(nb);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::sort(order.begin(), order.end(),
+            [&](std::size_t a, std::size_t b)
+            {
+                return buckets[a].size() > buckets[b].size();
+            });
+
+        std::vector<std::size_t> pos;
+        for(auto b : order)
+        {
+            auto const& keys = buckets[b];
+            if(keys.empty())
+                break;
+            std::uint32_t d = 1;
+            for(;; ++d)
+            {
+                if(d == 65536)
+                    return false;
+                pos.clear();
+                bool ok = true;
+                for(auto k : keys)
+                {
+                    auto const i = hash_ext(items[k].ext, d) & t.mask;
+                    if( ! t.slots[i].ext.empty() ||
+                        std::find(pos.begin(), pos.end(), i) != pos.end())
+                    {
+                        ok = false;
+                        break;
+                    }
+                    pos.push_back(i);
+                }
+                if(ok)
+                    break;
+            }
+            t.disp[b] = d;
+            for(std::size_t j = 0; j < keys.size(); ++j)
+                t.slots[pos[j]] = items[keys[j]];
+        }
+        return true;
+    }
+
+public:
+    void
+    add(
+        core::string_view ext,
+        core::string_view type,
+        core::string_view charset,
+        bool compressible)
+    {
+        if(ext.empty() || ext.size() > max_ext || type.empty())
+            return;
+        std::string key(ext);
+        for(auto& c : key)
+            c = ascii_lower(c);
+        record r{ key, std::string(type),
+            std::string(charset), compressible };
+        auto const [it, inserted] =
+            index_.try_emplace(std::move(key), v_.size());
+        if(inserted)
+            v_.push_back(std::move(r));
+        else
+            v_[it->second] = std::move(r);
+    }
+
+    // Add a type from a source without metadata
+    void
+    add_type(
+        core::string_view ext,
+        core::string_view type)
+    {
+        if(auto const* e = mime_db::lookup(type))
+            return add(ext, type, e->charset, e->compressible);
+        bool const text = type.starts_with("text/");
+        bool const structured =
+            type.ends_with("json") ||
+            type.ends_with("xml");
+        add(ext, type, text ? "UTF-8" : "", text || structured);
+    }
+
+    void
+    add_builtin()
+    {
+        for(auto const& e : detail::mime_exts)
+            add_type(e.ext, e.type);
+    }
+
+    // The views in t refer to t.strings,
+    // so t is filled in place
+    void
+    build(table& t) const
+    {
+        std::size_t total = 0;
+        for(auto const& r : v_)
+            total += r.ext.size() + r.type.size() + r.charset.size();
+        t.strings.reserve(total);
+        auto const put = [&t](std::string const& s)
+        {
+            auto const pos = t.strings.size();
+            t.strings.append(s);
+            return core::string_view(
+                t.strings.data() + pos, s.size());
+        };
+
+        std::vector<slot> items;
+        items.reserve(v_.size());
+        for(auto const& r : v_)
+        {
+            slot s;
+            s.ext = put(r.ext);
+            s.entry.type = put(r.type);
+            s.entry.charset = put(r.charset);
+            s.entry.compressible = r.compressible;
+            items.push_back(s);
+        }
+        t.count = items.size();
+
+        std::size_t cap = 1;
+        while(cap < 2 * items.size())
+            cap <<= 1;
+        while(! place(t, items, cap))
+            cap <<= 1;
+    }
+};
+
+} // (anon)
+
+struct mime_map::impl
+{
+    table t;
+};
+
+mime_map::
+mime_map()
+{
+    static std::shared_ptr<impl const> const sp = []
+    {
+        builder b;
+        b.add_builtin();
+        auto p = std::make_shared<impl>();
+        b.build(p->t);
+        return p;
+    }();
+    impl_ = sp;
+}
+
+mime_map
+mime_map::
+from_mime_types(core::string_view text)
+{
+    builder b;
+    b.add_builtin();
+    while(! text.empty())
+    {
+        auto const eol = text.find('\n');
+        auto line = text.substr(0, eol);
+        text.remove_prefix(eol == core::string_view::npos ?
+            text.size() : eol + 1);
+        auto const hash = line.find('#');
+        if(hash != core::string_view::npos)
+            line = line.substr(0, hash);
+
+        // type ext1 ext2 ...
+        core::string_view type;
+        for(;;)
+        {
+            auto const first = line.find_first_not_of(" \t\r");
+            if(first == core::string_view::npos)
+                break;
+            line.remove_prefix(first);
+            auto const tok = line.substr(0,
+                line.find_first_of(" \t\r"));
+            line.remove_prefix(tok.size());
+            if(type.empty())
+            {
+                if(tok.find('/') == core::string_view::npos)
+                    break;
+                type = tok;
+                continue;
+            }
+            b.add_type(tok, type);
+        }
+    }
+    auto p = std::make_shared<impl>();
+    b.build(p->t);
+    return mime_map(std::move(p));
+}
+
+mime_map
+mime_map::
+from_json(core::string_view text)
+{
+    auto const sv = [](json::string const& s)
+    {
+        return core::string_view(s.data(), s.size());
+    };
+
+    system::error_code ec;
+    auto const jv = json::parse(
+        json::string_view(text.data(), text.size()), ec);
+    if(ec.failed() || ! jv.is_object())
+        detail::throw_invalid_argument(
+            "mime_map: not a JSON object");
+
+    builder b;
+    b.add_builtin();
+    for(auto const& kv : jv.get_object())
+    {
+        if(! kv.value().is_object())
+            continue;
+        auto const& o = kv.value().get_object();
+        auto const* exts = o.if_contains("extensions");
+        if(! exts || ! exts->is_array())
+            continue;
+        core::string_view charset;
+        if(auto const* v = o.if_contains("charset"))
+            if(v->is_string())
+                charset = sv(v->get_string());
+        bool compressible = false;
+        if(auto const* v = o.if_contains("compressible"))
+            if(v->is_bool())
+                compressible = v->get_bool();
+        core::string_view const type(
+            kv.key().data(), kv.key().size());
+        for(auto const& e : exts->get_array())
+            if(e.is_string())
+                b.add(sv(e.get_string()), type,
+                    charset, compressible);
+    }
+    auto p = std::make_shared<impl>();
+    b.build(p->t);
+    return mime_map(std::move(p));
+}
+
+mime_map
+mime_map::
+load(char const* path)
+{
+    file f(path, file_mode::scan);
+    std::string s;
+    s.resize(static_cast<std::size_t>(f.size()));
+    std::size_t n = 0;
+    while(n < s.size())
+    {
+        auto const n1 = f.read(&s[n], s.size() - n);
+        if(n1 == 0)
+            break;
+        n += n1;
+    }
+    s.resize(n);
+
+    auto const first = s.find_first_not_of(" \t\r\n");
+    if(first != std::string::npos && s[first] == '{')
+        return from_json(s);
+    return from_mime_types(s);
+}
+
+mime_type_entry const*
+mime_map::
+find(core::string_view path_or_ext) const noexcept
+{
+    return impl_->t.find(path_or_ext);
+}
+
+std::string
+mime_map::
+content_type(core::string_view path_or_ext) const
+{
+    auto const* e = find(path_or_ext);
+    if(! e)
+        return {};
+    std::string s(e->type);
+    if(! e->charset.empty())
+    {
+        s.append("; charset=");
+        s.append(e->charset.data(), e->charset.size());
+    }
+    return s;
+}
+
+std::size_t
+mime_map::
+size() const noexcept
+{
+    return impl_->t.count;
+}
+
+} // http
+} // boost
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cctype>
 #include <charconv>
+#include <limits>
 
 namespace boost {
 namespace http {
@@ -116,6 +117,16 @@ parse_range_spec(
 
 range_result
 parse_range( std::int64_t size, core::string_view header )
+{
+    return parse_range( size, header,
+        ( std::numeric_limits<std::size_t>::max )() );
+}
+
+range_result
+parse_range(
+    std::int64_t size,
+    core::string_view header,
+    std::size_t max_ranges )
 {
     range_result result;
     result.type = range_result_type::malformed;
@@ -151,6 +162,7 @@ parse_range( std::int64_t size, core::string_view header )
 
     // Parse range specs
     bool any_satisfiable = false;
+    std::size_t count = 0;
 
     while( ! header.empty() )
     {
@@ -158,6 +170,14 @@ parse_range( std::int64_t size, core::string_view header )
         if( header.empty() )
             break;
 
+        // Too many ranges, ignore the field
+        if( ++count > max_ranges )
+        {
+            result.ranges.clear();
+            result.type = range_result_type::malformed;
+            return result;
+        }
+
         byte_range range;
         if( parse_range_spec( header, size, range ) )
         {
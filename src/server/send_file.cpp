@@ -8,56 +8,97 @@
 //
 
 #include <boost/http/server/send_file.hpp>
+#include <boost/http/server/conditional.hpp>
 #include <boost/http/server/etag.hpp>
-#include <boost/http/server/fresh.hpp>
-#include <boost/http/server/mime_types.hpp>
+#include <boost/http/server/mime_map.hpp>
 #include <boost/http/server/range_parser.hpp>
+#include <boost/http/error.hpp>
 #include <boost/http/field.hpp>
 #include <boost/http/status.hpp>
+
+#include "src/server/detail/file_root.hpp"
+#include "src/server/detail/send_file.hpp"
+
+#include <algorithm>
 #include <ctime>
-#include <filesystem>
+#include <memory>
 
 namespace boost {
 namespace http {
 
 namespace {
 
-// Get file stats
-bool
-get_file_stats(
-    core::string_view path,
-    std::uint64_t& size,
-    std::uint64_t& mtime)
+// Sort the ranges and merge those which
+// overlap or are adjacent (RFC 9110 14.2)
+void
+coalesce(std::vector<byte_range>& v)
+{
+    if(v.size() < 2)
+        return;
+    std::sort(v.begin(), v.end(),
+        [](byte_range const& a, byte_range const& b)
+        {
+            return a.start < b.start;
+        });
+    std::size_t n = 0;
+    for(std::size_t i = 1; i < v.size(); ++i)
+    {
+        if(v[i].start <= v[n].end + 1)
+        {
+            if(v[n].end < v[i].end)
+                v[n].end = v[i].end;
+            continue;
+        }
+        v[++n] = v[i];
+    }
+    v.resize(n + 1);
+}
+
+// The boundary must not occur in the body. Mixing
+// a counter with the file identity makes a collision
+// with file content vanishingly unlikely.
+std::string
+make_boundary(send_file_info const& info)
 {
-    system::error_code ec;
-    std::filesystem::path p(path.begin(), path.end());
-
-    auto status = std::filesystem::status(p, ec);
-    if(ec.failed() || ! std::filesystem::is_regular_file(status))
-        return false;
-
-    size = static_cast<std::uint64_t>(
-        std::filesystem::file_size(p, ec));
-    if(ec.failed())
-        return false;
-
-    auto ftime = std::filesystem::last_write_time(p, ec);
-    if(ec.failed())
-        return false;
-
-    // Convert to Unix timestamp
-    auto const sctp = std::chrono::time_point_cast<
-        std::chrono::system_clock::duration>(
-            ftime - std::filesystem::file_time_type::clock::now() +
-            std::chrono::system_clock::now());
-    mtime = static_cast<std::uint64_t>(
-        std::chrono::system_clock::to_time_t(sctp));
-
-    return true;
+    thread_local std::uint64_t counter = 0;
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ ++counter;
+    h ^= info.mtime + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= info.size + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= reinterpret_cast<std::uintptr_t>(&counter);
+
+    static constexpr char hex[] = "0123456789abcdef";
+    std::string s = "boost_http_";
+    for(int i = 60; i >= 0; i -= 4)
+        s.push_back(hex[(h >> i) & 0xf]);
+    return s;
 }
 
 } // (anon)
 
+std::string
+send_file_delimiter(
+    send_file_info const& info,
+    std::size_t i)
+{
+    std::string s = "\r\n--";
+    s.append(info.boundary);
+    if(i >= info.ranges.size())
+    {
+        s.append("--\r\n");
+        return s;
+    }
+    s.append("\r\nContent-Type: ");
+    s.append(info.content_type);
+    s.append("\r\nContent-Range: bytes ");
+    s.append(std::to_string(info.ranges[i].start));
+    s.push_back('-');
+    s.append(std::to_string(info.ranges[i].end));
+    s.push_back('/');
+    s.append(std::to_string(info.size));
+    s.append("\r\n\r\n");
+    return s;
+}
+
 std::string
 format_http_date(std::uint64_t mtime)
 {
@@ -84,12 +125,19 @@ send_file_init(
 {
     info = send_file_info{};
 
-    // Get file stats
-    if(! get_file_stats(path, info.size, info.mtime))
+    // One open and one fstat, and the
+    // descriptor is kept for the body
+    detail::file_stat st;
+    if( ! detail::open_file(info.file, path, st) ||
+        ! st.is_regular)
     {
+        system::error_code ec;
+        info.file.close(ec);
         info.result = send_file_result::not_found;
         return;
     }
+    info.size = st.size;
+    info.mtime = st.mtime;
 
     // Determine content type
     if(! opts.content_type.empty())
@@ -98,7 +146,7 @@ send_file_init(
     }
     else
     {
-        auto ct = mime_types::content_type(path);
+        auto ct = mime_map().content_type(path);
         if(ct.empty())
             ct = "application/octet-stream";
         info.content_type = std::move(ct);
@@ -106,17 +154,155 @@ send_file_init(
 
     // Generate ETag if enabled
     if(opts.etag)
-    {
         info.etag = etag(info.size, info.mtime);
-        rp.res.set(field::etag, info.etag);
+
+    // Format Last-Modified if enabled
+    if(opts.last_modified)
+        info.last_modified = format_http_date(info.mtime);
+
+    detail::send_file_prepare(info, rp, opts);
+}
+
+capy::io_task<>
+send_file_body(
+    route_params& rp,
+    send_file_info& info,
+    file_reader* io)
+{
+    auto& f = info.file;
+    std::int64_t remaining =
+        info.range_end - info.range_start + 1;
+
+    // The buffers live on the heap so the coroutine
+    // frame stays small, and overlapped reads get
+    // a second one.
+    constexpr std::size_t buf_size = 16384;
+    std::int64_t longest = remaining;
+    for(auto const& r : info.ranges)
+        longest = (std::max)(longest, r.end - r.start + 1);
+    std::size_t const buf_len = static_cast<std::size_t>(
+        (std::min)(longest, static_cast<std::int64_t>(buf_size)));
+    std::unique_ptr<char[]> const storage(
+        new char[io ? 2 * buf_len : buf_len]);
+    char* const buffer[2] = {
+        storage.get(), storage.get() + (io ? buf_len : 0) };
+    auto const to_read = [&](std::int64_t n)
+    {
+        return static_cast<std::size_t>(
+            (std::min)(n, static_cast<std::int64_t>(buf_len)));
+    };
+
+    // One part per range of a multipart response
+    std::size_t const parts =
+        info.ranges.empty() ? 1 : info.ranges.size();
+    for(std::size_t i = 0; i < parts; ++i)
+    {
+        std::int64_t offset = info.range_start;
+        if(! info.ranges.empty())
+        {
+            offset = info.ranges[i].start;
+            remaining = info.ranges[i].end - offset + 1;
+            auto const d = send_file_delimiter(info, i);
+            auto [ec, n] = co_await rp.res_body.write(
+                capy::const_buffer(d.data(), d.size()));
+            (void)n;
+            if(ec)
+                co_return {ec};
+        }
+
+        if(io)
+        {
+            // Read the next buffer while
+            // writing the current one
+            std::size_t cur = 0;
+            if(remaining > 0)
+                io->start_read(f,
+                    static_cast<std::uint64_t>(offset),
+                    capy::mutable_buffer(
+                        buffer[cur], to_read(remaining)));
+            while(remaining > 0)
+            {
+                auto [ec, n1] = co_await io->wait_read();
+                if(ec)
+                    co_return {ec};
+                // The file shrank after it was opened
+                if(n1 == 0)
+                    co_return {error::incomplete};
+                remaining -= static_cast<std::int64_t>(n1);
+                offset += static_cast<std::int64_t>(n1);
+                if(remaining > 0)
+                    io->start_read(f,
+                        static_cast<std::uint64_t>(offset),
+                        capy::mutable_buffer(
+                            buffer[cur ^ 1], to_read(remaining)));
+
+                auto [ec2, n2] = co_await rp.res_body.write(
+                    capy::const_buffer(buffer[cur], n1));
+                (void)n2;
+                if(ec2)
+                {
+                    // The buffer must outlive the read
+                    if(remaining > 0)
+                        (void)co_await io->wait_read();
+                    co_return {ec2};
+                }
+                cur ^= 1;
+            }
+            continue;
+        }
+
+        // The descriptor may be anywhere
+        system::error_code ec;
+        f.seek(static_cast<std::uint64_t>(offset), ec);
+        if(ec.failed())
+            co_return {ec};
+        while(remaining > 0)
+        {
+            auto const n1 = f.read(buffer[0], to_read(remaining), ec);
+            if(ec.failed())
+                co_return {ec};
+            // The file shrank after it was opened
+            if(n1 == 0)
+                co_return {error::incomplete};
+
+            auto [ec2, n2] = co_await rp.res_body.write(
+                capy::const_buffer(buffer[0], n1));
+            (void)n2;
+            if(ec2)
+                co_return {ec2};
+            remaining -= static_cast<std::int64_t>(n1);
+        }
     }
 
+    if(! info.ranges.empty())
+    {
+        auto const d = send_file_delimiter(info, info.ranges.size());
+        auto [ec, n] = co_await rp.res_body.write(
+            capy::const_buffer(d.data(), d.size()));
+        (void)n;
+        if(ec)
+            co_return {ec};
+    }
+
+    auto [ec] = co_await rp.res_body.write_eof();
+    co_return {ec};
+}
+
+namespace detail {
+
+void
+send_file_prepare(
+    send_file_info& info,
+    route_params& rp,
+    send_file_options const& opts)
+{
+    // Set ETag if enabled
+    if(opts.etag)
+        rp.res.set(field::etag, info.etag);
+
     // Set Last-Modified if enabled
     if(opts.last_modified)
-    {
-        info.last_modified = format_http_date(info.mtime);
         rp.res.set(field::last_modified, info.last_modified);
-    }
 
     // Set Cache-Control
     if(opts.max_age > 0)
@@ -126,28 +312,74 @@ send_file_init(
         rp.res.set(field::cache_control, cc);
     }
 
-    // Check freshness (conditional GET)
-    if(is_fresh(rp.req, rp.res))
+    // Find the conditional and Range fields once,
+    // the checks below read them from the request
+    auto const& hf = rp.req.hot();
+
+    // Evaluate conditional request fields
+    switch(evaluate_preconditions(rp.req, rp.res))
     {
+    case precondition_result::not_modified:
         info.result = send_file_result::not_modified;
         return;
+
+    case precondition_result::precondition_failed:
+        rp.res.set_status(status::precondition_failed);
+        info.result = send_file_result::error;
+        return;
+
+    case precondition_result::ok:
+        break;
     }
 
     // Set Content-Type
     rp.res.set(field::content_type, info.content_type);
 
     // Handle Range header
-    auto range_header = rp.req.value_or(field::range, "");
-    if(! range_header.empty())
+    // If-Range falls back to the full content
+    // when the representation has changed
+    auto const range_header = hf.range;
+    if(! range_header.empty() &&
+        if_range_matches(rp.req, rp.res))
     {
         auto range_result = parse_range(
             static_cast<std::int64_t>(info.size),
-            range_header);
+            range_header, opts.max_ranges);
+
+        if(range_result.type == range_result_type::ok)
+            coalesce(range_result.ranges);
+
+        if(range_result.type == range_result_type::ok &&
+            range_result.ranges.size() > 1)
+        {
+            info.is_range = true;
+            info.ranges = std::move(range_result.ranges);
+            info.boundary = make_boundary(info);
+
+            rp.res.set_status(status::partial_content);
+            rp.res.set(field::content_type,
+                "multipart/byteranges; boundary=" +
+                    info.boundary);
+
+            // The delimiters are known in advance, so the
+            // body size is exact and no chunking is needed
+            std::uint64_t n = 0;
+            for(std::size_t i = 0; i < info.ranges.size(); ++i)
+                n += send_file_delimiter(info, i).size() +
+                    static_cast<std::uint64_t>(
+                        info.ranges[i].end -
+                        info.ranges[i].start + 1);
+            n += send_file_delimiter(
+                info, info.ranges.size()).size();
+            rp.res.set_payload_size(n);
+
+            info.result = send_file_result::ok;
+            return;
+        }
 
         if(range_result.type == range_result_type::ok &&
-            ! range_result.ranges.empty())
+            range_result.ranges.size() == 1)
         {
-            // Use first range only (simplification)
             auto const& range = range_result.ranges[0];
             info.is_range = true;
             info.range_start = range.start;
@@ -181,7 +413,8 @@ send_file_init(
             info.result = send_file_result::error;
             return;
         }
-        // If malformed, ignore and serve full content
+        // If malformed or there are too many
+        // ranges, ignore and serve full content
     }
 
     // Full content response
@@ -192,5 +425,7 @@ send_file_init(
     info.result = send_file_result::ok;
 }
 
+} // detail
+
 } // http
 } // boost
@@ -8,11 +8,22 @@
 //
 
 #include <boost/http/server/serve_static.hpp>
+#include <boost/http/server/etag.hpp>
+#include <boost/http/server/file_read_pool.hpp>
 #include <boost/http/server/send_file.hpp>
 #include <boost/http/field.hpp>
 #include <boost/http/file.hpp>
 #include <boost/http/status.hpp>
-#include <filesystem>
+#include <boost/url/grammar/ci_string.hpp>
+
+#include "src/server/detail/body_cache.hpp"
+#include "src/server/detail/file_cache.hpp"
+#include "src/server/detail/file_root.hpp"
+#include "src/server/detail/send_file.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
 #include <string>
 
 namespace boost {
@@ -20,37 +31,6 @@ namespace http {
 
 namespace {
 
-// Append an HTTP rel-path to a local filesystem path.
-void
-path_cat(
-    std::string& result,
-    core::string_view prefix,
-    core::string_view suffix)
-{
-    result = prefix;
-
-#ifdef BOOST_MSVC
-    char constexpr path_separator = '\\';
-#else
-    char constexpr path_separator = '/';
-#endif
-    if(! result.empty() && result.back() == path_separator)
-        result.resize(result.size() - 1);
-
-#ifdef BOOST_MSVC
-    for(auto& c : result)
-        if(c == '/')
-            c = path_separator;
-#endif
-    for(auto const& c : suffix)
-    {
-        if(c == '/')
-            result.push_back(path_separator);
-        else
-            result.push_back(c);
-    }
-}
-
 // Check if path segment is a dotfile
 bool
 is_dotfile(core::string_view path) noexcept
@@ -67,12 +47,160 @@ is_dotfile(core::string_view path) noexcept
     return false;
 }
 
+// Returns the quality value, in thousandths, which an
+// Accept-Encoding field value assigns to a content-coding
+int
+encoding_quality(
+    core::string_view accept,
+    core::string_view coding) noexcept
+{
+    auto const trim = [](core::string_view v)
+    {
+        while(! v.empty() && (v.front() == ' ' || v.front() == '\t'))
+            v.remove_prefix(1);
+        while(! v.empty() && (v.back() == ' ' || v.back() == '\t'))
+            v.remove_suffix(1);
+        return v;
+    };
+
+    // Parse a qvalue, "0" to "1.000"
+    auto const parse_q = [](core::string_view v)
+    {
+        if(v.empty() || (v[0] != '0' && v[0] != '1'))
+            return 0;
+        int q = (v[0] - '0') * 1000;
+        if(v.size() > 1 && v[1] == '.')
+        {
+            int scale = 100;
+            for(std::size_t i = 2; i < v.size() && i < 5; ++i)
+            {
+                if(v[i] < '0' || v[i] > '9')
+                    break;
+                q += (v[i] - '0') * scale;
+                scale /= 10;
+            }
+        }
+        return (std::min)(q, 1000);
+    };
+
+    int star = -1;
+    while(! accept.empty())
+    {
+        auto pos = accept.find(',');
+        auto item = accept.substr(0, pos);
+        accept.remove_prefix(
+            pos == core::string_view::npos ?
+                accept.size() : pos + 1);
+
+        // coding [ ";" "q=" qvalue ]
+        int q = 1000;
+        auto const semi = item.find(';');
+        if(semi != core::string_view::npos)
+        {
+            auto param = trim(item.substr(semi + 1));
+            if( param.size() >= 2 &&
+                (param[0] == 'q' || param[0] == 'Q') &&
+                param[1] == '=')
+                q = parse_q(param.substr(2));
+            item = item.substr(0, semi);
+        }
+        item = trim(item);
+        if(urls::grammar::ci_is_equal(item, coding))
+            return q;
+        if(item == "*")
+            star = q;
+    }
+    return star < 0 ? 0 : star;
+}
+
+using file_entry = detail::file_cache::entry;
+
+// Look up a precompressed sibling of a file. The
+// sibling holds its descriptor for sending the body.
+std::shared_ptr<file_entry const>
+sibling(
+    file_entry const& e,
+    detail::file_root const& root,
+    core::string_view rel,
+    core::string_view ext)
+{
+    std::string srel(rel);
+    srel.append(ext.data(), ext.size());
+    file f;
+    detail::file_stat st;
+    if(! root.open(f, srel, st) || ! st.is_regular)
+        return nullptr;
+    auto s = std::make_shared<file_entry>();
+    s->path = e.path;
+    s->path.append(ext.data(), ext.size());
+    s->rel = std::move(srel);
+    s->found = true;
+    s->size = st.size;
+    s->mtime = st.mtime;
+    s->etag = etag(s->size, s->mtime);
+    s->release(std::move(f));
+    return s;
+}
+
+// Resolve a request path to a file and its metadata.
+// The file is opened relative to the root, and its
+// descriptor is left in f for sending the body.
+void
+lookup(
+    file_entry& e,
+    file& f,
+    detail::file_root const& root,
+    core::string_view req_path,
+    bool index,
+    bool precompressed,
+    mime_map const& mime)
+{
+    std::string rel(req_path);
+    detail::file_stat st;
+    if(! root.open(f, rel, st))
+        return;
+
+    e.is_dir = st.is_dir;
+    if(e.is_dir && index)
+    {
+        if(rel.empty() || rel.back() != '/')
+            rel.push_back('/');
+        rel.append("index.html");
+        if(! root.open(f, rel, st))
+            st = {};
+    }
+    if(! st.is_regular)
+    {
+        system::error_code ec;
+        f.close(ec);
+        return;
+    }
+
+    e.path = detail::path_cat(root.path(), rel);
+    e.rel = std::move(rel);
+    e.found = true;
+    e.size = st.size;
+    e.mtime = st.mtime;
+    e.content_type = mime.content_type(e.path);
+    if(e.content_type.empty())
+        e.content_type = "application/octet-stream";
+    e.etag = etag(e.size, e.mtime);
+    e.last_modified = format_http_date(e.mtime);
+    if(precompressed)
+    {
+        e.br = sibling(e, root, e.rel, ".br");
+        e.gz = sibling(e, root, e.rel, ".gz");
+    }
+}
+
 } // (anon)
 
 struct serve_static::impl
 {
-    std::string root;
+    detail::file_root root;
     serve_static_options opts;
+    std::unique_ptr<detail::file_cache> cache;
+    std::unique_ptr<detail::body_cache> bodies;
 
     impl(
         core::string_view root_,
@@ -80,6 +208,13 @@ struct serve_static::impl
         : root(root_)
         , opts(opts_)
     {
+        if(opts.cache_size > 0)
+            cache = std::make_unique<detail::file_cache>(
+                opts.cache_size,
+                std::chrono::seconds(opts.cache_ttl));
+        if(opts.memory_cache_size > 0)
+            bodies = std::make_unique<detail::body_cache>(
+                opts.memory_cache_size);
     }
 };
 
@@ -162,41 +297,43 @@ operator()(route_params& rp) const
         }
     }
 
-    // Build the file path
-    std::string path;
-    path_cat(path, impl_->root, req_path);
-
-    // Check if it's a directory
-    system::error_code fec;
-    bool is_dir = std::filesystem::is_directory(path, fec);
-    if(is_dir && ! fec.failed())
+    // Resolve the file, from the cache when possible.
+    // A lookup leaves the file open, and the cache
+    // entry keeps the descriptor for the body.
+    file f;
+    std::shared_ptr<file_entry const> fe;
+    if(impl_->cache)
+        fe = impl_->cache->find(req_path);
+    if(! fe)
     {
-        // Check for trailing slash
-        if(req_path.empty() || req_path.back() != '/')
+        auto e = std::make_shared<file_entry>();
+        lookup(*e, f, impl_->root, req_path,
+            impl_->opts.index, impl_->opts.precompressed,
+            impl_->opts.mime);
+        // Misses are not cached, so requests for
+        // paths that do not exist cannot evict files
+        if(impl_->cache && (e->found || e->is_dir))
         {
-            if(impl_->opts.redirect)
-            {
-                // Redirect to add trailing slash
-                std::string location(req_path);
-                location += '/';
-                rp.res.set_status(status::moved_permanently);
-                rp.res.set(field::location, location);
-                auto [ec] = co_await rp.send("");
-                if(ec)
-                    co_return route_error(ec);
-                co_return route_done;
-            }
+            e->release(std::move(f));
+            impl_->cache->insert(req_path, e);
         }
+        fe = std::move(e);
+    }
 
-        // Try index file
-        if(impl_->opts.index)
-        {
-#ifdef BOOST_MSVC
-            path += "\\index.html";
-#else
-            path += "/index.html";
-#endif
-        }
+    // Check for trailing slash on a directory
+    if( fe->is_dir &&
+        (req_path.empty() || req_path.back() != '/') &&
+        impl_->opts.redirect)
+    {
+        // Redirect to add trailing slash
+        std::string location(req_path);
+        location += '/';
+        rp.res.set_status(status::moved_permanently);
+        rp.res.set(field::location, location);
+        auto [ec] = co_await rp.send("");
+        if(ec)
+            co_return route_error(ec);
+        co_return route_done;
     }
 
     // Prepare file response using send_file utilities
@@ -205,8 +342,41 @@ operator()(route_params& rp) const
     opts.last_modified = impl_->opts.last_modified;
     opts.max_age = impl_->opts.max_age;
 
+    // Pick the precompressed sibling the client prefers
+    file_entry const* body = fe.get();
+    if(fe->found && (fe->br || fe->gz))
+    {
+        rp.res.append(field::vary, "Accept-Encoding");
+        auto const ae = rp.req.hot().accept_encoding;
+        int const qb = fe->br ?
+            encoding_quality(ae, "br") : 0;
+        int const qg = fe->gz ? (std::max)(
+            encoding_quality(ae, "gzip"),
+            encoding_quality(ae, "x-gzip")) : 0;
+        if(qb > 0 && qb >= qg)
+        {
+            body = fe->br.get();
+            rp.res.set(field::content_encoding, "br");
+        }
+        else if(qg > 0)
+        {
+            body = fe->gz.get();
+            rp.res.set(field::content_encoding, "gzip");
+        }
+    }
+
     send_file_info info;
-    send_file_init(info, rp, path, opts);
+    if(fe->found)
+    {
+        info.size = body->size;
+        info.mtime = body->mtime;
+        info.content_type = fe->content_type;
+        if(opts.etag)
+            info.etag = body->etag;
+        if(opts.last_modified)
+            info.last_modified = fe->last_modified;
+        detail::send_file_prepare(info, rp, opts);
+    }
 
     // Handle result
     switch(info.result)
@@ -233,7 +403,8 @@ operator()(route_params& rp) const
 
     case send_file_result::error:
     {
-        // Range error - headers already set by send_file_init
+        // Unsatisfiable range or failed precondition,
+        // the status is already set
         auto [ec] = co_await rp.send("");
         if(ec)
             co_return route_error(ec);
@@ -265,62 +436,165 @@ operator()(route_params& rp) const
         co_return route_done;
     }
 
-    // Open and stream the file
-    file f;
+    // Read on the pool when the server gave no reader
+    std::optional<pooled_file_reader> pooled;
+    file_reader* io = rp.file_io;
+    if(! io && impl_->opts.read_pool)
+        io = &pooled.emplace(*impl_->opts.read_pool);
+
+    // Small files are served from memory when cached
+    bool const in_memory = impl_->bodies &&
+        body->size <= impl_->opts.memory_cache_max_file;
+    detail::body_cache::body_type data;
+    if(in_memory)
+        data = impl_->bodies->find(
+            body->path, body->size, body->mtime);
+
+    // Stream the file through the descriptor opened
+    // by the lookup, or a cached one when it is free.
+    // Otherwise the file is opened again below the root.
     system::error_code ec;
-    f.open(path.c_str(), file_mode::scan, ec);
-    if(ec)
+    bool reused = false;
+    if(! data)
     {
-        if(impl_->opts.fallthrough)
-            co_return route_next;
-        rp.res.set_status(status::internal_server_error);
-        auto [ec2] = co_await rp.send("Internal Server Error");
-        if(ec2)
-            co_return route_error(ec2);
-        co_return route_done;
+        if(body != fe.get())
+            f = file();
+        if(! f.is_open())
+        {
+            reused = body->acquire(f);
+            detail::file_stat st;
+            if( ! reused && (
+                ! impl_->root.open(f, body->rel, st) ||
+                ! st.is_regular))
+                ec = make_error_code(
+                    system::errc::no_such_file_or_directory);
+        }
+        if(ec)
+        {
+            if(impl_->opts.fallthrough)
+                co_return route_next;
+            rp.res.set_status(status::internal_server_error);
+            auto [ec2] = co_await rp.send("Internal Server Error");
+            if(ec2)
+                co_return route_error(ec2);
+            co_return route_done;
+        }
     }
 
-    // Seek to range start if needed
-    if(info.is_range && info.range_start > 0)
+    // Read a small file whole and keep it
+    if(in_memory && ! data)
     {
-        f.seek(static_cast<std::uint64_t>(info.range_start), ec);
-        if(ec.failed())
+        std::string s;
+        s.resize(static_cast<std::size_t>(body->size));
+        std::size_t n = 0;
+        if(reused && ! io)
+            f.seek(0, ec);
+        while(! ec.failed() && n < s.size())
+        {
+            std::size_t n1;
+            if(io)
+            {
+                io->start_read(f, n,
+                    capy::mutable_buffer(&s[n], s.size() - n));
+                auto [ec2, n2] = co_await io->wait_read();
+                ec = ec2;
+                n1 = n2;
+            }
+            else
+            {
+                n1 = f.read(&s[n], s.size() - n, ec);
+            }
+            if(n1 == 0)
+                break;
+            n += n1;
+        }
+        if(impl_->cache)
+            body->release(std::move(f));
+        if(ec.failed() || n != s.size())
         {
+            // Headers are not yet sent
             rp.res.set_status(status::internal_server_error);
             auto [ec2] = co_await rp.send("Internal Server Error");
             if(ec2)
                 co_return route_error(ec2);
             co_return route_done;
         }
+        data = std::make_shared<std::string const>(std::move(s));
+        impl_->bodies->insert(body->path, body->mtime, data);
     }
 
-    // Calculate how much to send
-    std::int64_t remaining = info.range_end - info.range_start + 1;
-
-    // Stream file content
-    constexpr std::size_t buf_size = 16384;
-    char buffer[buf_size];
-
-    while(remaining > 0)
+    if(data)
     {
-        auto const to_read = static_cast<std::size_t>(
-            (std::min)(remaining, static_cast<std::int64_t>(buf_size)));
+        auto const slice = [&](std::int64_t first, std::int64_t last)
+        {
+            return capy::const_buffer(
+                data->data() + first,
+                static_cast<std::size_t>(last - first + 1));
+        };
 
-        auto const n1 = f.read(buffer, to_read, ec);
-        if(ec.failed() || n1 == 0)
-            break;
+        if(info.ranges.empty())
+        {
+            auto [ec2, n2] = co_await rp.res_body.write(
+                slice(info.range_start, info.range_end), true);
+            (void)n2;
+            if(ec2)
+                co_return route_error(ec2);
+            co_return route_done;
+        }
 
+        for(std::size_t i = 0; i < info.ranges.size(); ++i)
+        {
+            auto const d = send_file_delimiter(info, i);
+            auto [ec2, n2] = co_await rp.res_body.write(
+                capy::const_buffer(d.data(), d.size()));
+            (void)n2;
+            if(ec2)
+                co_return route_error(ec2);
+            auto [ec3, n3] = co_await rp.res_body.write(
+                slice(info.ranges[i].start, info.ranges[i].end));
+            (void)n3;
+            if(ec3)
+                co_return route_error(ec3);
+        }
+        auto const d = send_file_delimiter(info, info.ranges.size());
         auto [ec2, n2] = co_await rp.res_body.write(
-            capy::const_buffer(buffer, n1));
+            capy::const_buffer(d.data(), d.size()), true);
         (void)n2;
         if(ec2)
             co_return route_error(ec2);
-        remaining -= static_cast<std::int64_t>(n1);
+        co_return route_done;
+    }
+
+    // Calculate how much to send
+    std::int64_t remaining = info.range_end - info.range_start + 1;
+
+    // Send the range without copying when the transport
+    // supports it and no content-coding is to be applied.
+    // A multipart body interleaves delimiters, so it is
+    // always copied.
+    if( rp.res_file &&
+        info.ranges.empty() &&
+        (body != fe.get() ||
+            ! rp.res.exists(field::content_encoding)))
+    {
+        auto [ec2] = co_await rp.res_file->send_file(f,
+            static_cast<std::uint64_t>(info.range_start),
+            static_cast<std::uint64_t>(remaining));
+        if(impl_->cache)
+            body->release(std::move(f));
+        if(ec2)
+            co_return route_error(ec2);
+        co_return route_done;
     }
 
-    auto [ec3] = co_await rp.res_body.write_eof();
-    if(ec3)
-        co_return route_error(ec3);
+    // Stream the file, one part per range
+    // of a multipart response
+    info.file = std::move(f);
+    auto [ec2] = co_await send_file_body(rp, info, io);
+    if(impl_->cache && ! ec2)
+        body->release(std::move(info.file));
+    if(ec2)
+        co_return route_error(ec2);
     co_return route_done;
 }
 
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2025 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#include <boost/http/shared_fields.hpp>
+#include <boost/http/detail/except.hpp>
+
+namespace boost {
+namespace http {
+
+shared_fields::
+shared_fields(
+    fields const& f)
+{
+    for(auto const& e : f)
+    {
+        if(! e.id)
+            continue;
+        switch(*e.id)
+        {
+        case field::connection:
+        case field::content_encoding:
+        case field::content_length:
+        case field::expect:
+        case field::transfer_encoding:
+        case field::upgrade:
+            detail::throw_invalid_argument(
+                "shared_fields: field affects message metadata");
+        default:
+            break;
+        }
+    }
+    p_ = std::make_shared<fields const>(f);
+}
+
+fields const&
+shared_fields::
+get() const noexcept
+{
+    static fields const empty;
+    if(! p_)
+        return empty;
+    return *p_;
+}
+
+} // http
+} // boost
@@ -0,0 +1,25 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// A static route pattern with a parameter
+// must be rejected at compile time.
+
+#include <boost/http/server/static_routes.hpp>
+
+namespace boost {
+namespace http {
+
+auto const r = static_route<"/users/:id">(
+    [](route_params_base&) -> route_result
+    {
+        return route_done;
+    });
+
+} // http
+} // boost
@@ -12,11 +12,14 @@
 #include <boost/http/fields.hpp>
 
 #include <boost/http/field.hpp>
+#include <boost/http/request.hpp>
+#include <boost/http/response.hpp>
 #include <boost/core/detail/string_view.hpp>
 
 #include "test_helpers.hpp"
 #include "test_suite.hpp"
 
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 
@@ -331,12 +334,122 @@ struct fields_test
         }
     }
 
+    void
+    testMemoryResource()
+    {
+        struct counting_resource
+            : std::pmr::memory_resource
+        {
+            std::size_t allocs = 0;
+            std::size_t deallocs = 0;
+
+            void*
+            do_allocate(
+                std::size_t n,
+                std::size_t align) override
+            {
+                ++allocs;
+                return std::pmr::new_delete_resource()
+                    ->allocate(n, align);
+            }
+
+            void
+            do_deallocate(
+                void* p,
+                std::size_t n,
+                std::size_t align) override
+            {
+                ++deallocs;
+                std::pmr::new_delete_resource()
+                    ->deallocate(p, n, align);
+            }
+
+            bool
+            do_is_equal(
+                std::pmr::memory_resource const& other)
+                    const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        // default uses operator new
+        {
+            fields f;
+            BOOST_TEST_EQ(
+                f.get_memory_resource(), nullptr);
+        }
+
+        // storage comes from the resource
+        {
+            counting_resource mr;
+            {
+                fields f(&mr);
+                BOOST_TEST_EQ(
+                    f.get_memory_resource(), &mr);
+                BOOST_TEST_EQ(mr.allocs, 0);
+                for(int i = 0; i < 64; ++i)
+                    f.append(field::accept, "text/html");
+                BOOST_TEST_EQ(f.size(), 64);
+                BOOST_TEST_GT(mr.allocs, 0);
+
+                // growth is geometric
+                BOOST_TEST_LT(mr.allocs, 16);
+
+                // copies do not inherit the resource
+                fields f2(f);
+                BOOST_TEST_EQ(
+                    f2.get_memory_resource(), nullptr);
+                BOOST_TEST(f2.buffer() == f.buffer());
+            }
+            BOOST_TEST_EQ(mr.allocs, mr.deallocs);
+        }
+
+        // swap and move exchange the resource
+        {
+            counting_resource mr;
+            {
+                fields f1(&mr);
+                f1.append(field::host, "example.com");
+                fields f2;
+                f2.swap(f1);
+                BOOST_TEST_EQ(
+                    f2.get_memory_resource(), &mr);
+                BOOST_TEST_EQ(
+                    f1.get_memory_resource(), nullptr);
+                fields f3(std::move(f2));
+                BOOST_TEST_EQ(
+                    f3.get_memory_resource(), &mr);
+                BOOST_TEST_EQ(f3.at(field::host), "example.com");
+            }
+            BOOST_TEST_EQ(mr.allocs, mr.deallocs);
+        }
+
+        // request and response
+        {
+            counting_resource mr;
+            {
+                request req(&mr);
+                req.set(field::host, "example.com");
+                response res(&mr);
+                res.set(field::server, "test");
+                BOOST_TEST_EQ(
+                    req.get_memory_resource(), &mr);
+                BOOST_TEST_EQ(
+                    res.get_memory_resource(), &mr);
+                BOOST_TEST_EQ(mr.allocs, 2);
+            }
+            BOOST_TEST_EQ(mr.allocs, mr.deallocs);
+        }
+    }
+
     void
     run()
     {
         testSpecial();
         testObservers();
         testInitialSize();
+        testMemoryResource();
     }
 };
 
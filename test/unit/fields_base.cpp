@@ -22,6 +22,7 @@
 #include "test_helpers.hpp"
 #include "test_suite.hpp"
 
+#include <iterator>
 #include <stdexcept>
 #include <vector>
 
@@ -565,6 +566,52 @@ struct fields_base_test
             "X:\r\n"
             "Y:\r\n"
             "\r\n");
+
+        // append(initializer_list)
+
+        check(
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append({});
+            },
+            "\r\n");
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append({
+                    { field::server, "y" },
+                    { field::content_length, " 42 " },
+                    { field::cache_control, "" },
+                    { field::connection, "keep-alive\r\n close" } });
+            },
+            "Cookie: x\r\n"
+            "Server: y\r\n"
+            "Content-Length: 42\r\n"
+            "Cache-Control:\r\n"
+            "Connection: keep-alive   close\r\n"
+            "\r\n");
+
+        check_error(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                system::error_code ec;
+                f.append({
+                    { field::server, "y" },
+                    { field::age, "bad\r\nvalue" } }, ec);
+                BOOST_TEST(ec == error::bad_field_smuggle);
+                BOOST_TEST_EQ(f.size(), 1);
+                BOOST_TEST_THROWS(
+                    f.append({
+                        { field::server, "bad\rvalue" } }),
+                    system::system_error);
+                BOOST_TEST_EQ(f.size(), 1);
+            });
     }
 
     void
@@ -1721,6 +1768,246 @@ struct fields_base_test
     {
     }
 
+    void
+    testDeferredCompaction()
+    {
+        // erase and set
+        {
+            fields f(
+                "Server: x\r\n"
+                "Vary: Accept\r\n"
+                "Keep-Alive: 5\r\n"
+                "X-Hop: 1\r\n"
+                "Vary: Origin\r\n"
+                "\r\n");
+            BOOST_TEST(! f.deferred_compaction());
+            f.set_deferred_compaction(true);
+            BOOST_TEST(f.deferred_compaction());
+            BOOST_TEST_EQ(f.erase(field::keep_alive), 1);
+            BOOST_TEST_EQ(f.erase("x-hop"), 1);
+            BOOST_TEST_EQ(f.erase("X-Missing"), 0);
+            f.set(field::vary, "Accept-Encoding");
+            f.set("Server", "y");
+            f.append(field::age, "0");
+            BOOST_TEST_EQ(f.size(), 4);
+            BOOST_TEST_EQ(f.buffer(),
+                "Vary: Accept-Encoding\r\n"
+                "Server: y\r\n"
+                "Age: 0\r\n"
+                "\r\n");
+            test_fields(f, f.buffer());
+        }
+
+        // observers see the compacted fields
+        {
+            fields f(
+                "A: 1\r\n"
+                "B: 2\r\n"
+                "A: 3\r\n"
+                "\r\n");
+            f.set_deferred_compaction(true);
+            f.erase("A");
+            BOOST_TEST_EQ(f.count("A"), 0);
+            BOOST_TEST(f.begin()->name == "B");
+            f.set("B", "4");
+            f.erase("B");
+            f.set_deferred_compaction(false);
+            BOOST_TEST_EQ(f.buffer(), "\r\n");
+            BOOST_TEST_EQ(f.size(), 0);
+        }
+
+        // lookups and iteration skip erased fields
+        {
+            fields f(
+                "A: 1\r\n"
+                "B: 2\r\n"
+                "C: 3\r\n"
+                "A: 4\r\n"
+                "D: 5\r\n"
+                "\r\n");
+            f.set_deferred_compaction(true);
+            f.erase("A");
+            f.erase("D");
+            fields const& cf = f;
+            BOOST_TEST_EQ(cf.size(), 2);
+            BOOST_TEST(! cf.exists("A"));
+            BOOST_TEST_EQ(cf.value_or("C", ""), "3");
+            BOOST_TEST_EQ(std::distance(cf.begin(), cf.end()), 2);
+            BOOST_TEST(cf.begin()->name == "B");
+            BOOST_TEST((--cf.end())->name == "C");
+            BOOST_TEST(cf.rbegin()->name == "C");
+            BOOST_TEST_EQ(std::distance(cf.rbegin(), cf.rend()), 2);
+            BOOST_TEST(cf.find_last(cf.end(), "B")->name == "B");
+
+            // edits interleaved with lookups
+            f.set("B", "6");
+            BOOST_TEST_EQ(f.at("B"), "6");
+            f.erase("C");
+            BOOST_TEST_EQ(cf.size(), 1);
+            auto it = f.find("B");
+            BOOST_TEST(it != f.end());
+            BOOST_TEST(++it == f.end());
+            f.append("E", "7");
+            BOOST_TEST_EQ(f.size(), 2);
+
+            // a copy has no erased fields
+            fields const f2(f);
+            BOOST_TEST_EQ(f2.buffer(),
+                "B: 6\r\n"
+                "E: 7\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(f.buffer(), f2.buffer());
+        }
+
+        // special fields are erased in place
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "Server: x\r\n"
+                "\r\n");
+            req.set_deferred_compaction(true);
+            req.erase(field::server);
+            req.erase(field::content_length);
+            BOOST_TEST_EQ(
+                req.metadata().content_length.count, 0);
+            req.set(field::content_length, "3");
+            BOOST_TEST_EQ(
+                req.metadata().content_length.value, 3);
+            BOOST_TEST_EQ(req.buffer(),
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n");
+        }
+
+        // copies and moves
+        {
+            fields f(
+                "A: 1\r\n"
+                "B: 2\r\n"
+                "\r\n");
+            f.set_deferred_compaction(true);
+            f.erase("A");
+            fields const f2(f);
+            BOOST_TEST_EQ(f2.buffer(), "B: 2\r\n\r\n");
+            f.erase("B");
+            fields f3(std::move(f));
+            BOOST_TEST_EQ(f3.buffer(), "\r\n");
+        }
+
+        // const buffer and explicit compaction
+        {
+            fields f(
+                "A: 1\r\n"
+                "B: 2\r\n"
+                "C: 3\r\n"
+                "\r\n");
+            fields const& cf = f;
+            f.set_deferred_compaction(true);
+            f.erase("B");
+            BOOST_TEST_THROWS(cf.buffer(), std::logic_error);
+            BOOST_TEST_EQ(cf.size(), 2);
+            f.compact();
+            BOOST_TEST(f.deferred_compaction());
+            BOOST_TEST_EQ(cf.buffer(),
+                "A: 1\r\n"
+                "C: 3\r\n"
+                "\r\n");
+            f.compact();
+            BOOST_TEST_EQ(cf.size(), 2);
+        }
+
+        // repeated edits reclaim space
+        {
+            fields f;
+            f.set_deferred_compaction(true);
+            for(int i = 0; i < 10; ++i)
+                f.set(field::vary, "Origin");
+            auto const cap = f.capacity_in_bytes();
+            for(int i = 0; i < 1000; ++i)
+                f.set(field::vary, "Origin");
+            BOOST_TEST_EQ(f.capacity_in_bytes(), cap);
+            BOOST_TEST_EQ(f.buffer(),
+                "Vary: Origin\r\n"
+                "\r\n");
+        }
+    }
+
+    void
+    testFindAfterEdits()
+    {
+        // find(field) agrees with a linear scan
+        auto const check = [](fields_base const& f)
+        {
+            for(auto id : {
+                field::accept,
+                field::accept_encoding,
+                field::authorization,
+                field::cookie,
+                field::host,
+                field::if_match,
+                field::if_modified_since,
+                field::if_none_match,
+                field::if_range,
+                field::if_unmodified_since,
+                field::origin,
+                field::range })
+            {
+                auto it = f.begin();
+                while(it != f.end() && it->id != id)
+                    ++it;
+                BOOST_TEST(f.find(id) == it);
+            }
+        };
+
+        request req(
+            "GET / HTTP/1.1\r\n"
+            "User-Agent: x\r\n"
+            "Host: a\r\n"
+            "Range: bytes=0-1\r\n"
+            "Cookie: c=1\r\n"
+            "Host: b\r\n"
+            "\r\n");
+        check(req);
+        BOOST_TEST_EQ(req.at(field::host), "a");
+        BOOST_TEST_EQ(req.at(field::range), "bytes=0-1");
+
+        req.insert(req.begin(), field::cookie, "c=0");
+        check(req);
+        BOOST_TEST_EQ(req.at(field::cookie), "c=0");
+
+        req.erase(req.find(field::host));
+        check(req);
+        BOOST_TEST_EQ(req.at(field::host), "b");
+
+        req.erase(field::cookie);
+        check(req);
+        BOOST_TEST(! req.exists(field::cookie));
+
+        req.append({
+            { field::if_none_match, "\"x\"" },
+            { field::accept, "*/*" } });
+        check(req);
+
+        req.set(field::host, "c");
+        check(req);
+        BOOST_TEST_EQ(req.at(field::host), "c");
+
+        req.set_deferred_compaction(true);
+        req.set(field::range, "bytes=2-3");
+        req.erase(field::accept);
+        check(req);
+        BOOST_TEST_EQ(req.at(field::range), "bytes=2-3");
+        BOOST_TEST(! req.exists(field::accept));
+
+        request req2(req);
+        check(req2);
+        req.clear();
+        check(req);
+        BOOST_TEST(! req.exists(field::range));
+        BOOST_TEST_EQ(req2.at(field::host), "c");
+    }
+
     void
     run()
     {
@@ -1734,6 +2021,8 @@ struct fields_base_test
         testObservers();
         testStream();
         testSubrange();
+        testDeferredCompaction();
+        testFindAfterEdits();
     }
 };
 
@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/hot_fields.hpp>
+
+#include <boost/http/request.hpp>
+#include <boost/http/static_request.hpp>
+
+#include <string>
+#include <utility>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http {
+
+struct hot_fields_test
+{
+    // true if every view of v lies within
+    // the buffer of req
+    static
+    bool
+    in_buffer(
+        request_base const& req,
+        hot_fields const& v)
+    {
+        auto const b = req.buffer();
+        auto const in = [&](core::string_view s)
+        {
+            return s.data() == nullptr || (
+                s.data() >= b.data() &&
+                s.data() + s.size() <= b.data() + b.size());
+        };
+        return
+            in(v.host) && in(v.range) &&
+            in(v.if_range) && in(v.accept_encoding) &&
+            in(v.cookie) && in(v.authorization);
+    }
+
+    void
+    testFind()
+    {
+        {
+            request req;
+            auto const& v = req.hot();
+            BOOST_TEST(v.host.empty());
+            BOOST_TEST(v.range.empty());
+            BOOST_TEST_EQ(v.if_match, 0u);
+            BOOST_TEST_EQ(v.if_none_match, 0u);
+            BOOST_TEST(! v.has_if_modified_since);
+            BOOST_TEST(! v.has_if_unmodified_since);
+        }
+
+        request req(
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Range: bytes=0-9\r\n"
+            "If-Range: \"abc\"\r\n"
+            "Accept-Encoding: br, gzip\r\n"
+            "Cookie: a=1\r\n"
+            "Cookie: b=2\r\n"
+            "Authorization: Basic eDp5\r\n"
+            "If-Match: \"x\"\r\n"
+            "If-None-Match: \"y\"\r\n"
+            "If-None-Match: \"z\"\r\n"
+            "If-Modified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "If-Unmodified-Since: bogus\r\n"
+            "\r\n");
+        auto const& v = req.hot();
+        BOOST_TEST_EQ(v.host, "example.com");
+        BOOST_TEST_EQ(v.range, "bytes=0-9");
+        BOOST_TEST_EQ(v.if_range, "\"abc\"");
+        BOOST_TEST_EQ(v.accept_encoding, "br, gzip");
+        BOOST_TEST_EQ(v.cookie, "a=1");
+        BOOST_TEST_EQ(v.authorization, "Basic eDp5");
+        BOOST_TEST_EQ(v.if_match, 1u);
+        BOOST_TEST_EQ(v.if_none_match, 2u);
+        BOOST_TEST(v.has_if_modified_since);
+        BOOST_TEST_EQ(v.if_modified_since, 784111777u);
+        BOOST_TEST(! v.has_if_unmodified_since);
+        BOOST_TEST(in_buffer(req, v));
+
+        // kept until the next modification
+        BOOST_TEST_EQ(&req.hot(), &v);
+        request const& cr = req;
+        BOOST_TEST_EQ(cr.hot().range.data(), v.range.data());
+    }
+
+    void
+    testInvalidate()
+    {
+        request req(
+            "GET / HTTP/1.1\r\n"
+            "Range: bytes=0-9\r\n"
+            "\r\n");
+        BOOST_TEST_EQ(req.hot().range, "bytes=0-9");
+
+        // set in place
+        req.set(field::range, "bytes=5-6");
+        BOOST_TEST_EQ(req.hot().range, "bytes=5-6");
+
+        // growth which reallocates
+        req.set(field::range, std::string(2000, 'x'));
+        BOOST_TEST_EQ(req.hot().range.size(), 2000u);
+        BOOST_TEST(in_buffer(req, req.hot()));
+
+        // a new start line moves the fields
+        req.set_start_line(method::get,
+            "/a/much/longer/target", version::http_1_1);
+        BOOST_TEST(in_buffer(req, req.hot()));
+        BOOST_TEST_EQ(req.hot().range.size(), 2000u);
+
+        req.erase(field::range);
+        BOOST_TEST(req.hot().range.empty());
+
+        req.append(field::if_none_match, "\"a\"");
+        BOOST_TEST_EQ(req.hot().if_none_match, 1u);
+
+        req.append(field::if_modified_since,
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BOOST_TEST(req.hot().has_if_modified_since);
+
+        req.clear();
+        BOOST_TEST_EQ(req.hot().if_none_match, 0u);
+        BOOST_TEST(! req.hot().has_if_modified_since);
+
+        // erasure with deferred compaction
+        req.set_deferred_compaction(true);
+        req.append(field::cookie, "a=1");
+        req.append(field::host, "h");
+        BOOST_TEST_EQ(req.hot().cookie, "a=1");
+        req.erase(field::cookie);
+        BOOST_TEST(req.hot().cookie.empty());
+        BOOST_TEST_EQ(req.hot().host, "h");
+        req.compact();
+        BOOST_TEST_EQ(req.hot().host, "h");
+        BOOST_TEST(in_buffer(req, req.hot()));
+
+        // the const overload does not keep
+        // what it finds, yet stays current
+        request const& cr = req;
+        req.set(field::host, "other");
+        BOOST_TEST_EQ(cr.hot().host, "other");
+    }
+
+    void
+    testCopyMove()
+    {
+        request r0(
+            "GET / HTTP/1.1\r\n"
+            "Host: a\r\n"
+            "\r\n");
+        request r1(
+            "GET / HTTP/1.1\r\n"
+            "Host: bb\r\n"
+            "\r\n");
+        BOOST_TEST_EQ(r0.hot().host, "a");
+        BOOST_TEST_EQ(r1.hot().host, "bb");
+
+        {
+            request c(r0);
+            BOOST_TEST_EQ(c.hot().host, "a");
+            BOOST_TEST(in_buffer(c, c.hot()));
+        }
+        {
+            request c;
+            c = r1;
+            BOOST_TEST_EQ(c.hot().host, "bb");
+            BOOST_TEST(in_buffer(c, c.hot()));
+        }
+
+        r0.swap(r1);
+        BOOST_TEST_EQ(r0.hot().host, "bb");
+        BOOST_TEST_EQ(r1.hot().host, "a");
+        BOOST_TEST(in_buffer(r0, r0.hot()));
+        BOOST_TEST(in_buffer(r1, r1.hot()));
+
+        request m(std::move(r0));
+        BOOST_TEST_EQ(m.hot().host, "bb");
+        BOOST_TEST(r0.hot().host.empty());
+
+        char buf[1024];
+        static_request s(buf, sizeof(buf));
+        s = m;
+        BOOST_TEST_EQ(s.hot().host, "bb");
+        BOOST_TEST(in_buffer(s, s.hot()));
+        static_request s2(std::move(s));
+        BOOST_TEST_EQ(s2.hot().host, "bb");
+        BOOST_TEST(in_buffer(s2, s2.hot()));
+    }
+
+    void
+    run()
+    {
+        testFind();
+        testInvalidate();
+        testCopyMove();
+    }
+};
+
+TEST_SUITE(
+    hot_fields_test,
+    "boost.http.hot_fields");
+
+} // http
+} // boost
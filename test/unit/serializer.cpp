@@ -11,16 +11,19 @@
 // Test that header file is self-contained.
 #include <boost/http/serializer.hpp>
 #include <boost/http/response.hpp>
+#include <boost/http/shared_fields.hpp>
 
 #include <boost/capy/buffers/buffer_copy.hpp>
 #include <boost/capy/buffers/make_buffer.hpp>
 #include <boost/capy/buffers/slice.hpp>
 #include <boost/capy/buffers/string_dynamic_buffer.hpp>
 #include <boost/capy/concept/buffer_sink.hpp>
+#include <boost/capy/ex/system_context.hpp>
 #include <boost/capy/io/any_buffer_sink.hpp>
 #include <boost/capy/test/fuse.hpp>
 #include <boost/capy/test/write_stream.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <boost/http/zlib.hpp>
 
 #include "test_helpers.hpp"
 
@@ -248,6 +251,149 @@ struct serializer_test
             "0\r\n\r\n");
     }
 
+    void
+    testSharedFields()
+    {
+        fields f;
+        f.append(field::server, "test");
+        f.append(field::cache_control, "no-cache");
+        shared_fields const sf(f);
+
+        core::string_view const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 0\r\n"
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n"
+            "\r\n";
+
+        // empty body
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            res.set_shared_fields(sf);
+            serializer sr(cfg_);
+            sr.start(res);
+            auto cbs = sr.prepare().value();
+            BOOST_TEST_EQ(
+                capy::buffer_size(cbs), expected.size());
+            std::string s = read(sr);
+            BOOST_TEST(s == expected);
+        }
+
+        // consume across the shared block
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            res.set_shared_fields(sf);
+            serializer sr(cfg_);
+            sr.start(res);
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto cbs = sr.prepare().value();
+                auto const& cb = *cbs.begin();
+                s.push_back(*static_cast<
+                    char const*>(cb.data()));
+                sr.consume(1);
+            }
+            BOOST_TEST(s == expected);
+        }
+
+        // empty block
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            res.set_shared_fields({});
+            serializer sr(cfg_);
+            sr.start(res);
+            BOOST_TEST(read(sr) == res.buffer());
+        }
+    }
+
+    void
+    testDeferredCompaction()
+    {
+        // erased fields are not sent, and
+        // the message is not modified
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Keep-Alive: 5\r\n"
+                "Vary: Accept\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            res.set_deferred_compaction(true);
+            res.erase(field::keep_alive);
+            res.set(field::vary, "Origin");
+            response const& cres = res;
+            BOOST_TEST_THROWS(cres.buffer(), std::logic_error);
+
+            core::string_view const expected =
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 0\r\n"
+                "Vary: Origin\r\n"
+                "\r\n";
+            serializer sr(cfg_);
+            sr.start(cres);
+            BOOST_TEST(read(sr) == expected);
+            BOOST_TEST_THROWS(cres.buffer(), std::logic_error);
+
+            // one byte at a time
+            sr.start(cres);
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto cbs = sr.prepare().value();
+                auto const& cb = *cbs.begin();
+                s.push_back(*static_cast<
+                    char const*>(cb.data()));
+                sr.consume(1);
+            }
+            BOOST_TEST(s == expected);
+
+            res.compact();
+            BOOST_TEST_EQ(cres.buffer(), expected);
+        }
+
+        // many erased fields
+        {
+            response res(status::ok);
+            for(int i = 0; i < 40; ++i)
+                res.append(
+                    "X-" + std::to_string(i), "v");
+            res.set_content_length(0);
+            res.set_deferred_compaction(true);
+            for(int i = 0; i < 40; i += 2)
+                res.erase("X-" + std::to_string(i));
+
+            fields f;
+            f.append(field::server, "test");
+            res.set_shared_fields(shared_fields(f));
+
+            std::string expected =
+                "HTTP/1.1 200 OK\r\n";
+            for(int i = 1; i < 40; i += 2)
+                expected += "X-" + std::to_string(i) +
+                    ": v\r\n";
+            expected +=
+                "Content-Length: 0\r\n"
+                "Server: test\r\n"
+                "\r\n";
+            serializer sr(cfg_);
+            sr.start(res);
+            BOOST_TEST(read(sr) == expected);
+            BOOST_TEST_EQ(res.size(), 22);
+        }
+    }
+
     //--------------------------------------------
 
     void
@@ -745,6 +891,44 @@ struct serializer_test
         BOOST_TEST(sr.is_done());
     }
 
+    void
+    testEncodingWithContentLength()
+    {
+#ifdef BOOST_HTTP_HAS_ZLIB
+        auto& ctx = capy::get_system_context();
+        if(! ctx.find_service<zlib::deflate_service>())
+            zlib::install_deflate_service(ctx);
+
+        serializer_config cfg;
+        cfg.apply_gzip_encoder = true;
+        auto const gzip_cfg = make_serializer_config(cfg);
+
+        // a body with a size is sent as is,
+        // it may already be encoded
+        {
+            serializer sr(gzip_cfg);
+            response res;
+            res.set(field::content_encoding, "gzip");
+            res.set_payload_size(5);
+            sr.start(res, capy::const_buffer("12345", 5));
+            auto const s = read(sr);
+            BOOST_TEST(s.ends_with(
+                "Content-Length: 5\r\n\r\n12345"));
+        }
+
+        // otherwise the coding is applied
+        {
+            serializer sr(gzip_cfg);
+            response res;
+            res.set(field::content_encoding, "gzip");
+            res.set_chunked(true);
+            sr.start(res, capy::const_buffer("12345", 5));
+            auto const s = read(sr);
+            BOOST_TEST(s.find("12345") == std::string::npos);
+        }
+#endif
+    }
+
     //--------------------------------------------
     // Sink tests (BufferSink interface)
     //--------------------------------------------
@@ -1112,10 +1296,13 @@ struct serializer_test
         testSyntax();
         testSpecial();
         testEmptyBody();
+        testSharedFields();
+        testDeferredCompaction();
         testOutput();
         testExpect100Continue();
         testStreamErrors();
         testOverConsume();
+        testEncodingWithContentLength();
 
         // Sink tests (BufferSink interface)
         testSinkCommitBasic();
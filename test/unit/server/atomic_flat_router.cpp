@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/atomic_flat_router.hpp>
+
+#include <boost/http/server/basic_router.hpp>
+
+#include <boost/capy/test/run_blocking.hpp>
+#include "test_suite.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+struct atomic_flat_router_test
+{
+    using params = route_params_base;
+    using test_router = basic_router<params>;
+
+    void testStore()
+    {
+        auto log = std::make_shared<std::string>();
+        auto h = [log](char c)
+        {
+            return [log, c](params&) -> route_result
+            {
+                log->push_back(c);
+                return route_next;
+            };
+        };
+
+        test_router r1;
+        r1.use(h('a'));
+        test_router r2;
+        r2.use(h('b'));
+
+        atomic_flat_router routes{flat_router(std::move(r1))};
+
+        auto run = [&]
+        {
+            params req;
+            log->clear();
+            capy::test::run_blocking()(routes.dispatch(
+                http::method::get, urls::url_view("/"), req));
+            return *log;
+        };
+
+        BOOST_TEST_EQ(run(), "a");
+        routes.store(flat_router(std::move(r2)));
+        BOOST_TEST_EQ(run(), "b");
+        BOOST_TEST_EQ(run(), "b");
+    }
+
+    void testInFlight()
+    {
+        auto log = std::make_shared<std::string>();
+        std::unique_ptr<atomic_flat_router> routes;
+        auto alive = std::make_shared<int>(0);
+        std::weak_ptr<int> watch = alive;
+
+        test_router r1;
+        r1.use([&routes, log, alive](params&) -> route_result
+        {
+            // replace the routes in the middle of a dispatch
+            log->push_back('a');
+            test_router r2;
+            r2.use([log](params&) -> route_result
+            {
+                log->push_back('c');
+                return route_next;
+            });
+            routes->store(flat_router(std::move(r2)));
+            return route_next;
+        });
+        r1.use([log](params&) -> route_task
+        {
+            log->push_back('b');
+            co_return route_next;
+        });
+        alive.reset();
+
+        routes = std::make_unique<atomic_flat_router>(
+            flat_router(std::move(r1)));
+
+        params req;
+        capy::test::run_blocking()(routes->dispatch(
+            http::method::get, urls::url_view("/"), req));
+        BOOST_TEST_EQ(*log, "ab");
+
+        // the old routes are gone once no dispatch uses them
+        BOOST_TEST(watch.expired());
+
+        log->clear();
+        capy::test::run_blocking()(routes->dispatch(
+            "GET", urls::url_view("/"), req));
+        BOOST_TEST_EQ(*log, "c");
+    }
+
+    void testIdleThread()
+    {
+        auto make = [](std::shared_ptr<int> alive)
+        {
+            test_router r;
+            r.use([alive](params&) -> route_result
+            {
+                return route_next;
+            });
+            return flat_router(std::move(r));
+        };
+
+        auto alive = std::make_shared<int>(0);
+        std::weak_ptr<int> watch = alive;
+        auto routes = std::make_unique<atomic_flat_router>(
+            make(std::move(alive)));
+
+        // a worker which dispatches once when asked,
+        // then stays idle until asked again
+        std::mutex m;
+        std::condition_variable cv;
+        int asked = 0;
+        int done = 0;
+        bool quit = false;
+        std::thread t([&]
+        {
+            params req;
+            std::unique_lock<std::mutex> lock(m);
+            for(;;)
+            {
+                cv.wait(lock, [&]{ return quit || asked > done; });
+                if(quit)
+                    return;
+                lock.unlock();
+                capy::test::run_blocking()(routes->dispatch(
+                    http::method::get, urls::url_view("/"), req));
+                lock.lock();
+                ++done;
+                cv.notify_all();
+            }
+        });
+        auto const dispatch = [&]
+        {
+            std::unique_lock<std::mutex> lock(m);
+            ++asked;
+            cv.notify_all();
+            cv.wait(lock, [&]{ return done == asked; });
+        };
+
+        // store releases the idle thread's routes
+        dispatch();
+        BOOST_TEST(! watch.expired());
+        auto alive2 = std::make_shared<int>(0);
+        std::weak_ptr<int> watch2 = alive2;
+        routes->store(make(std::move(alive2)));
+        BOOST_TEST(watch.expired());
+
+        // and so does destruction
+        dispatch();
+        BOOST_TEST(! watch2.expired());
+        routes.reset();
+        BOOST_TEST(watch2.expired());
+
+        {
+            std::lock_guard<std::mutex> lock(m);
+            quit = true;
+        }
+        cv.notify_all();
+        t.join();
+    }
+
+    void testThreads()
+    {
+        auto count = std::make_shared<std::atomic<int>>(0);
+        auto make = [count](int n)
+        {
+            test_router r;
+            r.use([count, n](params&) -> route_result
+            {
+                count->fetch_add(n);
+                return route_next;
+            });
+            return flat_router(std::move(r));
+        };
+
+        atomic_flat_router routes(make(1));
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&]
+            {
+                params req;
+                for(int i = 0; i < 1000; ++i)
+                    capy::test::run_blocking()(routes.dispatch(
+                        http::method::get, urls::url_view("/"), req));
+            });
+        }
+        for(int i = 0; i < 100; ++i)
+            routes.store(make(1));
+        for(auto& t : threads)
+            t.join();
+        BOOST_TEST_EQ(count->load(), 4000);
+
+        // another object on the same thread
+        atomic_flat_router other(make(1000));
+        params req;
+        capy::test::run_blocking()(other.dispatch(
+            http::method::get, urls::url_view("/"), req));
+        capy::test::run_blocking()(routes.dispatch(
+            http::method::get, urls::url_view("/"), req));
+        BOOST_TEST_EQ(count->load(), 5001);
+    }
+
+    void run()
+    {
+        testStore();
+        testInFlight();
+        testIdleThread();
+        testThreads();
+    }
+};
+
+TEST_SUITE(
+    atomic_flat_router_test,
+    "boost.http.server.atomic_flat_router");
+
+} // http
+} // boost
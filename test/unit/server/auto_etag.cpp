@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/auto_etag.hpp>
+
+#include <boost/http/server/etag.hpp>
+
+#include <boost/capy/test/run_blocking.hpp>
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http {
+
+struct auto_etag_test
+{
+    // A buffer sink which keeps what reaches the wire
+    class sink
+    {
+        std::string buf_;
+        std::size_t size_ = 0;
+
+    public:
+        bool eof = false;
+
+        std::string
+        body() const
+        {
+            return buf_.substr(0, size_);
+        }
+
+        std::size_t
+        prepare(
+            capy::mutable_buffer* arr,
+            std::size_t max_count)
+        {
+            if(max_count == 0)
+                return 0;
+            if(buf_.size() - size_ < 4096)
+                buf_.resize(size_ + 4096);
+            arr[0] = capy::mutable_buffer(
+                &buf_[size_], buf_.size() - size_);
+            return 1;
+        }
+
+        capy::io_task<>
+        commit(std::size_t n)
+        {
+            return commit(n, false);
+        }
+
+        capy::io_task<>
+        commit(std::size_t n, bool end)
+        {
+            BOOST_TEST(! eof);
+            size_ += n;
+            eof = end;
+            co_return {};
+        }
+
+        capy::io_task<>
+        commit_eof()
+        {
+            BOOST_TEST(! eof);
+            eof = true;
+            co_return {};
+        }
+    };
+
+    // The outcome of one request
+    struct reply
+    {
+        route_result rv;
+        http::response res;
+        std::string body;
+        bool eof = false;
+    };
+
+    // Write body, ending it if end is set
+    static auto
+    writer(std::string body, bool end = true)
+    {
+        return [body, end](route_params& rp) -> route_task
+        {
+            rp.res.set(field::content_type, "text/plain");
+            auto [ec, n] = co_await rp.res_body.write(
+                capy::const_buffer(body.data(), body.size()), end);
+            (void)n;
+            if(ec)
+                co_return route_error(ec);
+            co_return route_done;
+        };
+    }
+
+    template<class Handler>
+    static reply
+    get(
+        auto_etag<Handler> const& h,
+        core::string_view if_none_match = {})
+    {
+        route_params rp;
+        sink s;
+        rp.req = request(method::get, "/");
+        if(! if_none_match.empty())
+            rp.req.set(field::if_none_match, if_none_match);
+        rp.res_body = capy::any_buffer_sink(s);
+        reply r;
+        capy::test::run_blocking(
+            [&](route_result rv) { r.rv = rv; })(h(rp));
+        r.res = rp.res;
+        r.body = s.body();
+        r.eof = s.eof;
+        return r;
+    }
+
+    void testTagged()
+    {
+        auto_etag h(writer("Hello, World!"));
+        auto r = get(h);
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST(r.res.status() == status::ok);
+        BOOST_TEST_EQ(r.res.value_or(field::etag, ""),
+            "\"d-c49aacf8080fe47f\"");
+        BOOST_TEST_EQ(r.res.payload_size(), 13u);
+        BOOST_TEST_EQ(r.body, "Hello, World!");
+        BOOST_TEST(r.eof);
+
+        // an ETag set by the handler is kept
+        auto_etag h2([](route_params& rp) -> route_task
+        {
+            rp.res.set(field::etag, "\"mine\"");
+            auto [ec, n] = co_await rp.res_body.write(
+                capy::const_buffer("abc", 3), true);
+            (void)n;
+            if(ec)
+                co_return route_error(ec);
+            co_return route_done;
+        });
+        r = get(h2);
+        BOOST_TEST_EQ(r.res.value_or(field::etag, ""), "\"mine\"");
+        BOOST_TEST_EQ(r.body, "abc");
+    }
+
+    void testNotModified()
+    {
+        auto_etag h(writer("Hello, World!"));
+        auto r = get(h, "\"d-c49aacf8080fe47f\"");
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST(r.res.status() == status::not_modified);
+        BOOST_TEST_EQ(r.res.value_or(field::etag, ""),
+            "\"d-c49aacf8080fe47f\"");
+        BOOST_TEST(! r.res.exists(field::content_type));
+        BOOST_TEST(r.body.empty());
+        BOOST_TEST(r.eof);
+
+        // a different tag gets the body
+        r = get(h, "\"other\"");
+        BOOST_TEST(r.res.status() == status::ok);
+        BOOST_TEST_EQ(r.body, "Hello, World!");
+    }
+
+    void testSpill()
+    {
+        // past the limit the body is sent untagged
+        auto_etag_options opts;
+        opts.limit = 8;
+        std::string const body(5000, 'x');
+        auto_etag h(writer(body), opts);
+        auto r = get(h, etag(body));
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST(r.res.status() == status::ok);
+        BOOST_TEST(! r.res.exists(field::etag));
+        BOOST_TEST_EQ(r.body, body);
+        BOOST_TEST(r.eof);
+
+        // at the limit it is still tagged
+        auto_etag h2(writer("12345678"), opts);
+        r = get(h2);
+        BOOST_TEST(r.res.exists(field::etag));
+        BOOST_TEST_EQ(r.body, "12345678");
+    }
+
+    void testUnended()
+    {
+        // a body the handler did not end is
+        // sent when it returns, without a tag
+        auto_etag h(writer("partial", false));
+        auto r = get(h);
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST(! r.res.exists(field::etag));
+        BOOST_TEST_EQ(r.body, "partial");
+        BOOST_TEST(! r.eof);
+    }
+
+    void run()
+    {
+        testTagged();
+        testNotModified();
+        testSpill();
+        testUnended();
+    }
+};
+
+TEST_SUITE(
+    auto_etag_test,
+    "boost.http.server.auto_etag");
+
+} // http
+} // boost
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/conditional.hpp>
+
+#include <boost/http/server/fresh.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http {
+
+struct conditional_test
+{
+    static constexpr core::string_view lm =
+        "Sun, 06 Nov 1994 08:49:37 GMT";
+
+    static response
+    make_response()
+    {
+        response res;
+        res.set(field::etag, "\"abc\"");
+        res.set(field::last_modified, lm);
+        return res;
+    }
+
+    void testParseDate()
+    {
+        auto check = [](core::string_view s, std::uint64_t t0)
+        {
+            std::uint64_t t = 0;
+            BOOST_TEST(parse_http_date(s, t));
+            BOOST_TEST_EQ(t, t0);
+        };
+        auto bad = [](core::string_view s)
+        {
+            std::uint64_t t;
+            BOOST_TEST(! parse_http_date(s, t));
+        };
+
+        check("Sun, 06 Nov 1994 08:49:37 GMT", 784111777);
+        check("Sunday, 06-Nov-94 08:49:37 GMT", 784111777);
+        check("Sun Nov  6 08:49:37 1994", 784111777);
+        check("Thu, 01 Jan 1970 00:00:00 GMT", 0);
+        check("Wednesday, 01-Mar-00 00:00:00 GMT", 951868800);
+        check("Wed Mar 12 13:14:15 2025", 1741785255);
+
+        bad("");
+        bad("Sun, 06 Nov 1994 08:49:37");
+        bad("Sun, 06 Nov 1994 08:49:37 UTC");
+        bad("Sun, 6 Nov 1994 08:49:37 GMT");
+        bad("Sun, 06 Foo 1994 08:49:37 GMT");
+        bad("Sun, 06 Nov 1994 24:00:00 GMT");
+        bad("Sun, 06 Nov 1969 08:49:37 GMT");
+        bad("Sun, 06 Nov 1994 08:49:37 GMT ");
+        bad("Sun Nov 06 08:49:37 94");
+    }
+
+    void testPreconditions()
+    {
+        auto check = [](
+            method verb,
+            field f,
+            core::string_view v,
+            precondition_result r)
+        {
+            request req;
+            req.set_method(verb);
+            req.set(f, v);
+            BOOST_TEST(evaluate_preconditions(
+                req, make_response()) == r);
+        };
+        auto const GET = method::get;
+        auto const PUT = method::put;
+        auto const ok = precondition_result::ok;
+        auto const nm = precondition_result::not_modified;
+        auto const pf = precondition_result::precondition_failed;
+
+        {
+            request req;
+            BOOST_TEST(evaluate_preconditions(
+                req, make_response()) == ok);
+        }
+
+        check(GET, field::if_none_match, "\"abc\"", nm);
+        check(GET, field::if_none_match, "W/\"abc\"", nm);
+        check(GET, field::if_none_match, "\"x\", \"abc\"", nm);
+        check(GET, field::if_none_match, "\"x\",\"ab\"", ok);
+        check(GET, field::if_none_match, "\"abcd\"", ok);
+        check(GET, field::if_none_match, "*", nm);
+        check(PUT, field::if_none_match, "*", pf);
+
+        check(PUT, field::if_match, "\"abc\"", ok);
+        check(PUT, field::if_match, "\"x\", \"abc\"", ok);
+        check(PUT, field::if_match, "W/\"abc\"", pf);
+        check(PUT, field::if_match, "\"x\"", pf);
+        check(PUT, field::if_match, "*", ok);
+
+        // dates compare as times, in any format
+        check(GET, field::if_modified_since, lm, nm);
+        check(GET, field::if_modified_since,
+            "Sunday, 06-Nov-94 08:49:37 GMT", nm);
+        check(GET, field::if_modified_since,
+            "Sun Nov  6 08:49:38 1994", nm);
+        check(GET, field::if_modified_since,
+            "Sun, 06 Nov 1994 08:49:36 GMT", ok);
+        check(GET, field::if_modified_since, "garbage", ok);
+        check(PUT, field::if_modified_since, lm, ok);
+
+        check(PUT, field::if_unmodified_since, lm, ok);
+        check(PUT, field::if_unmodified_since,
+            "Sun, 06 Nov 1994 08:49:36 GMT", pf);
+        check(PUT, field::if_unmodified_since, "garbage", ok);
+
+        // If-None-Match wins over If-Modified-Since
+        {
+            request req;
+            req.set(field::if_none_match, "\"x\"");
+            req.set(field::if_modified_since, lm);
+            BOOST_TEST(evaluate_preconditions(
+                req, make_response()) == ok);
+            BOOST_TEST(! is_fresh(req, make_response()));
+        }
+
+        // values of repeated fields form one list
+        {
+            request req;
+            req.append(field::if_none_match, "\"x\"");
+            req.append(field::if_none_match, "\"abc\"");
+            BOOST_TEST(evaluate_preconditions(
+                req, make_response()) == nm);
+            BOOST_TEST(is_fresh(req, make_response()));
+        }
+    }
+
+    void testIfRange()
+    {
+        auto check = [](core::string_view v, bool b)
+        {
+            request req;
+            req.set(field::range, "bytes=0-1");
+            if(! v.empty())
+                req.set(field::if_range, v);
+            BOOST_TEST_EQ(if_range_matches(
+                req, make_response()), b);
+        };
+
+        check("", true);
+        check("\"abc\"", true);
+        check("\"x\"", false);
+        check("W/\"abc\"", false);
+        check(lm, true);
+        check("Sun Nov  6 08:49:37 1994", true);
+        check("Sun, 06 Nov 1994 08:49:38 GMT", false);
+        check("garbage", false);
+    }
+
+    void run()
+    {
+        testParseDate();
+        testPreconditions();
+        testIfRange();
+    }
+};
+
+TEST_SUITE(
+    conditional_test,
+    "boost.http.server.conditional");
+
+} // http
+} // boost
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/etag.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http {
+
+struct etag_test
+{
+    void testContent()
+    {
+        // XXH64 known answers, short input and
+        // the four lane loop
+        BOOST_TEST_EQ(etag("Hello, World!"),
+            "\"d-c49aacf8080fe47f\"");
+        BOOST_TEST_EQ(etag(""),
+            "\"0-ef46db3751d8e999\"");
+        BOOST_TEST_EQ(etag("abc"),
+            "\"3-44bc2cf5ad770999\"");
+        BOOST_TEST_EQ(etag(
+            "Nobody inspects the spammish repetition"),
+            "\"27-fbcea83c8a378bf1\"");
+
+        etag_options opts;
+        opts.weak = true;
+        BOOST_TEST_EQ(etag("Hello, World!", opts),
+            "W/\"d-c49aacf8080fe47f\"");
+
+        // every byte of every tail length is hashed
+        std::string s(100, 'a');
+        for(std::size_t n = 1; n <= s.size(); ++n)
+        {
+            core::string_view const v(s.data(), n);
+            auto const tag = etag(v);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                s[i] = 'b';
+                BOOST_TEST_NE(etag(v), tag);
+                s[i] = 'a';
+            }
+        }
+    }
+
+    void testStat()
+    {
+        BOOST_TEST_EQ(etag(1234, 5678), "\"4d2-162e\"");
+        etag_options opts;
+        opts.weak = true;
+        BOOST_TEST_EQ(etag(0, 0, opts), "W/\"0-0\"");
+    }
+
+    void run()
+    {
+        testContent();
+        testStat();
+    }
+};
+
+TEST_SUITE(
+    etag_test,
+    "boost.http.server.etag");
+
+} // http
+} // boost
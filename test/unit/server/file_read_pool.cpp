@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/file_read_pool.hpp>
+
+#include <boost/http/file.hpp>
+
+#include "pump.hpp"
+#include "test_suite.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+struct file_read_pool_test
+{
+    std::filesystem::path path_;
+    std::string content_;
+
+    file_read_pool_test()
+    {
+        path_ = std::filesystem::temp_directory_path() /
+            ("boost_http_file_read_pool_" +
+                std::to_string(std::chrono::steady_clock::now()
+                    .time_since_epoch().count()));
+        for(std::size_t i = 0; i < 50000; ++i)
+            content_.push_back(static_cast<char>('a' + i % 26));
+        std::ofstream(path_, std::ios::binary) << content_;
+    }
+
+    ~file_read_pool_test()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    file
+    open()
+    {
+        file f;
+        f.open(path_.string().c_str(), file_mode::read);
+        return f;
+    }
+
+    void
+    testConstruct()
+    {
+        BOOST_TEST_EQ(file_read_pool().max_threads(), 4u);
+        BOOST_TEST_EQ(file_read_pool(0).max_threads(), 1u);
+        BOOST_TEST_EQ(file_read_pool(3).max_threads(), 3u);
+    }
+
+    void
+    testRead()
+    {
+        // reads wait in line for the only thread
+        file_read_pool pool(1);
+        pooled_file_reader r0(pool);
+        pooled_file_reader r1(pool);
+        file f0 = open();
+        file f1 = open();
+        file closed;
+        std::string b0(10, 0);
+        std::string b1(10, 0);
+        pump p;
+        auto rv = p.run([&]() -> route_task
+        {
+            // nothing was started
+            auto [ec, n] = co_await r0.wait_read();
+            BOOST_TEST(! ec);
+            BOOST_TEST_EQ(n, 0u);
+
+            r0.start_read(f0, 100,
+                capy::mutable_buffer(&b0[0], b0.size()));
+            r1.start_read(f1, 49995,
+                capy::mutable_buffer(&b1[0], b1.size()));
+            auto [ec0, n0] = co_await r0.wait_read();
+            BOOST_TEST(! ec0);
+            BOOST_TEST_EQ(n0, 10u);
+            BOOST_TEST_EQ(b0, content_.substr(100, 10));
+
+            // short at the end of the file
+            auto [ec1, n1] = co_await r1.wait_read();
+            BOOST_TEST(! ec1);
+            BOOST_TEST_EQ(n1, 5u);
+            BOOST_TEST_EQ(b1.substr(0, 5), content_.substr(49995));
+
+            // then nothing
+            r1.start_read(f1, 50000,
+                capy::mutable_buffer(&b1[0], b1.size()));
+            auto [ec2, n2] = co_await r1.wait_read();
+            BOOST_TEST(! ec2);
+            BOOST_TEST_EQ(n2, 0u);
+
+            // errors are handed back
+            r0.start_read(closed, 0,
+                capy::mutable_buffer(&b0[0], b0.size()));
+            auto [ec3, n3] = co_await r0.wait_read();
+            BOOST_TEST(ec3.failed());
+            BOOST_TEST_EQ(n3, 0u);
+
+            co_return route_done;
+        }());
+        BOOST_TEST(rv.what() == route_what::done);
+    }
+
+    void
+    testConcurrent()
+    {
+        // more readers than threads
+        std::size_t const count = 16;
+        std::size_t const len = content_.size() / count;
+        file_read_pool pool(4);
+        std::vector<std::unique_ptr<pooled_file_reader>> readers;
+        std::vector<file> files;
+        std::vector<std::string> bufs;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            readers.push_back(
+                std::make_unique<pooled_file_reader>(pool));
+            files.push_back(open());
+            bufs.emplace_back(len, 0);
+        }
+        pump p;
+        for(int round = 0; round < 8; ++round)
+        {
+            auto rv = p.run([&]() -> route_task
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                    readers[i]->start_read(files[i], i * len,
+                        capy::mutable_buffer(&bufs[i][0], len));
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    auto [ec, n] = co_await readers[i]->wait_read();
+                    BOOST_TEST(! ec);
+                    BOOST_TEST_EQ(n, len);
+                    BOOST_TEST_EQ(bufs[i], content_.substr(i * len, len));
+                }
+                co_return route_done;
+            }());
+            BOOST_TEST(rv.what() == route_what::done);
+        }
+    }
+
+    void
+    testDestroyPending()
+    {
+        // destroying a reader waits for its read
+        file_read_pool pool(1);
+        file f = open();
+        std::string b(1000, 0);
+        for(int i = 0; i < 8; ++i)
+        {
+            pooled_file_reader r(pool);
+            r.start_read(f, 0,
+                capy::mutable_buffer(&b[0], b.size()));
+        }
+        BOOST_TEST_EQ(b, content_.substr(0, 1000));
+    }
+
+    void
+    run()
+    {
+        testConstruct();
+        testRead();
+        testConcurrent();
+        testDestroyPending();
+    }
+};
+
+TEST_SUITE(
+    file_read_pool_test,
+    "boost.http.server.file_read_pool");
+
+} // http
+} // boost
@@ -18,6 +18,8 @@
 #include <boost/capy/test/run_blocking.hpp>
 #include "test_suite.hpp"
 
+#include <string>
+
 namespace boost {
 namespace http {
 
@@ -80,10 +82,333 @@ struct flat_router_test
         BOOST_TEST_EQ(*counter, 2);
     }
 
+    void testIndex()
+    {
+        auto log = std::make_shared<std::string>();
+        auto h = [log](char c)
+        {
+            return [log, c](params&) -> route_task
+            {
+                log->push_back(c);
+                co_return route_next;
+            };
+        };
+
+        test_router nested;
+        nested.use("/v1", h('n'));
+
+        test_router r;
+        r.use(h('a'));
+        r.use("/users", h('b'));
+        r.use("/api", h('c'));
+        r.use("/API", h('d'));
+        r.use("/api", std::move(nested));
+        r.use("/users/admin", h('e'));
+        r.use("/", h('f'));
+        r.use("/api/v", h('g'));
+
+        flat_router fr(std::move(r));
+
+        auto check = [&](
+            core::string_view path,
+            core::string_view expected)
+        {
+            params req;
+            log->clear();
+            capy::test::run_blocking()(fr.dispatch(
+                http::method::get, urls::url_view(path), req));
+            BOOST_TEST_EQ(*log, expected);
+        };
+
+        check("/", "af");
+        check("/users", "abf");
+        check("/users/admin", "abef");
+        check("/api/v1", "acdnfg");
+        check("/Api/V1/x", "acdnfg");
+        check("/apix", "acdf");
+        check("/other", "af");
+    }
+
+    void testDecodedPath()
+    {
+        auto seen = std::make_shared<std::string>();
+        test_router r;
+        r.use([seen](params& p) -> route_task
+        {
+            seen->assign(p.path.data(), p.path.size());
+            co_return route_result{};
+        });
+        flat_router fr(std::move(r));
+
+        auto check = [&](
+            core::string_view target,
+            core::string_view expected)
+        {
+            params req;
+            seen->clear();
+            capy::test::run_blocking()(fr.dispatch(
+                http::method::get, urls::url_view(target), req));
+            BOOST_TEST_EQ(*seen, expected);
+        };
+
+        check("/", "/");
+        check("/plain/path", "/plain/path");
+        check("/a%20b", "/a b");
+        check("/a%2Fb%5cc", "/a%2Fb%5cc");
+
+        // capacity is reused across dispatches
+        params req;
+        capy::test::run_blocking()(fr.dispatch(
+            http::method::get, urls::url_view("/x/y/z"), req));
+        auto const* data = req.path.data();
+        capy::test::run_blocking()(fr.dispatch(
+            http::method::get, urls::url_view("/a%20b"), req));
+        BOOST_TEST_EQ(req.path.data(), data);
+    }
+
+    void testHotCache()
+    {
+        auto log = std::make_shared<std::string>();
+        auto h = [log](char c, route_result rv)
+        {
+            return [log, c, rv](params&) -> route_task
+            {
+                log->push_back(c);
+                co_return rv;
+            };
+        };
+
+        auto make = [&]
+        {
+            test_router r;
+            r.use(h('a', route_next));
+            r.use("/api", h('b', route_next));
+            r.add(http::method::get, "/api/x",
+                h('c', route_next_route), h('z', route_done));
+            r.add(http::method::get, "/api/x", h('d', route_next));
+            r.add(http::method::post, "/api/x", h('e', route_done));
+            r.use("/api", [log](params&) -> route_result
+            {
+                log->push_back('f');
+                return route_error(error::bad_connection);
+            });
+            r.use([log](params&, system::error_code) -> route_result
+            {
+                log->push_back('g');
+                return route_done;
+            });
+            return r;
+        };
+
+        flat_router plain(make());
+        flat_router cached(make(), 16);
+
+        auto run = [&](
+            flat_router const& fr,
+            http::method verb,
+            core::string_view path)
+        {
+            params req;
+            log->clear();
+            capy::test::run_blocking()(fr.dispatch(
+                verb, urls::url_view(path), req));
+            return *log;
+        };
+
+        for(int n = 0; n < 3; ++n)
+        {
+            for(auto path : { "/", "/api/x", "/API/x", "/api/y", "/other" })
+            {
+                for(auto verb : { http::method::get, http::method::post })
+                {
+                    auto const expected = run(plain, verb, path);
+                    BOOST_TEST_EQ(run(cached, verb, path), expected);
+                }
+            }
+        }
+        BOOST_TEST_EQ(run(cached, http::method::get, "/api/x"), "abcdfg");
+        BOOST_TEST_EQ(run(cached, http::method::post, "/api/x"), "abe");
+
+        // copies share the cache
+        flat_router copy(cached);
+        BOOST_TEST_EQ(run(copy, http::method::get, "/api/x"), "abcdfg");
+
+        // a trailing slash is part of the key
+        {
+            test_router r(router_options().strict(true));
+            r.add(http::method::get, "/a", h('x', route_done));
+            r.add(http::method::get, "/a/", h('y', route_done));
+            flat_router fr(std::move(r), 16);
+            for(int n = 0; n < 3; ++n)
+            {
+                BOOST_TEST_EQ(run(fr, http::method::get, "/a"), "x");
+                BOOST_TEST_EQ(run(fr, http::method::get, "/a/"), "y");
+            }
+        }
+
+        // paths seen once do not fill the cache
+        {
+            test_router r;
+            r.use(h('a', route_next));
+            flat_router fr(std::move(r), 4);
+            for(int n = 0; n < 64; ++n)
+                run(fr, http::method::get,
+                    "/miss/" + std::to_string(n));
+            for(int n = 0; n < 3; ++n)
+                BOOST_TEST_EQ(run(fr, http::method::get, "/hot"), "a");
+        }
+    }
+
+    void testStats()
+    {
+        test_router r;
+        r.use([](params&) { return route_next; });
+        r.use("/api", []
+        {
+            test_router r2;
+            r2.add(http::method::get, "/x",
+                [](params&) -> route_task
+                {
+                    co_return route_done;
+                });
+            return r2;
+        }());
+        r.add(http::method::post, "/y",
+            [](params&) -> route_result
+            {
+                throw std::runtime_error("test");
+            });
+
+        flat_router fr(std::move(r));
+        BOOST_TEST(fr.stats().empty());
+        fr.enable_stats(2);
+
+        auto run = [&](
+            http::method verb,
+            core::string_view path)
+        {
+            params req;
+            capy::test::run_blocking()(fr.dispatch(
+                verb, urls::url_view(path), req));
+        };
+        run(http::method::get, "/api/x");
+        run(http::method::get, "/api/x");
+        run(http::method::post, "/y");
+        run(http::method::get, "/other");
+
+        auto const v = fr.stats();
+        BOOST_TEST_EQ(v.size(), 3u);
+        if(v.size() != 3)
+            return;
+
+        BOOST_TEST_EQ(v[0].pattern, "/");
+        BOOST_TEST_EQ(v[0].method, "");
+        BOOST_TEST_EQ(v[0].calls, 4u);
+        BOOST_TEST_EQ(v[0].outcomes[
+            static_cast<int>(route_what::next)], 4u);
+
+        BOOST_TEST_EQ(v[1].pattern, "/api/x");
+        BOOST_TEST_EQ(v[1].method, "GET");
+        BOOST_TEST_EQ(v[1].calls, 2u);
+        BOOST_TEST_EQ(v[1].outcomes[
+            static_cast<int>(route_what::done)], 2u);
+
+        BOOST_TEST_EQ(v[2].pattern, "/y");
+        BOOST_TEST_EQ(v[2].calls, 1u);
+        BOOST_TEST_EQ(v[2].outcomes[5], 1u);
+
+        std::uint64_t n = 0;
+        for(auto c : v[1].latency)
+            n += c;
+        BOOST_TEST_EQ(n, 2u);
+
+        route_stats total;
+        for(auto const& rs : v)
+            total.merge(rs);
+        BOOST_TEST_EQ(total.calls, 7u);
+    }
+
+    void testMethods()
+    {
+        auto log = std::make_shared<std::string>();
+        auto h = [log](char c)
+        {
+            return [log, c](params&) -> route_result
+            {
+                log->push_back(c);
+                return route_next;
+            };
+        };
+
+        test_router r;
+        r.use(h('m'));
+        r.route("/users")
+            .add(http::method::get, h('g'))
+            .add(http::method::post, h('p'))
+            .add("PURGEALL", h('c'));
+        {
+            // a scope holding only PUT routes
+            test_router api;
+            api.add(http::method::put, "/x", h('x'));
+            api.add(http::method::put, "/users", h('y'));
+            r.use("/api", std::move(api));
+        }
+        {
+            // middleware keeps its scope for every method
+            test_router v2;
+            v2.use(h('v'));
+            v2.add(http::method::put, "/x", h('z'));
+            r.use("/v2", std::move(v2));
+        }
+        flat_router fr(std::move(r));
+
+        auto run = [&](
+            http::method verb,
+            core::string_view url,
+            core::string_view log0,
+            core::string_view allow0)
+        {
+            params req;
+            log->clear();
+            route_result rv;
+            capy::test::run_blocking([&](route_result res) { rv = res; })(
+                fr.dispatch(verb, urls::url_view(url), req));
+            BOOST_TEST(rv.what() == route_what::next);
+            BOOST_TEST_EQ(*log, log0);
+            BOOST_TEST_EQ(fr.allowed_methods(req), allow0);
+        };
+
+        run(http::method::get, "/users", "mg", "GET, POST, PURGEALL");
+        run(http::method::delete_, "/users", "m", "GET, POST, PURGEALL");
+        run(http::method::get, "/api/x", "m", "PUT");
+        run(http::method::put, "/api/x", "mx", "PUT");
+        run(http::method::get, "/api/users", "m", "PUT");
+        run(http::method::get, "/v2/x", "mv", "PUT");
+        run(http::method::put, "/v2/x", "mvz", "PUT");
+        run(http::method::get, "/none", "m", "");
+
+        // custom verbs
+        {
+            params req;
+            log->clear();
+            capy::test::run_blocking()(fr.dispatch(
+                "PURGEALL", urls::url_view("/users"), req));
+            BOOST_TEST_EQ(*log, "mc");
+            capy::test::run_blocking()(fr.dispatch(
+                "OTHER", urls::url_view("/api/x"), req));
+            BOOST_TEST_EQ(*log, "mcm");
+        }
+    }
+
     void run()
     {
         testCopyConstruction();
         testCopyAssignment();
+        testIndex();
+        testDecodedPath();
+        testHotCache();
+        testStats();
+        testMethods();
     }
 };
 
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/mime_map.hpp>
+
+#include <boost/http/server/mime_types.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http {
+
+struct mime_map_test
+{
+    static core::string_view
+    type(mime_map const& m, core::string_view s)
+    {
+        auto const* e = m.find(s);
+        if(! e)
+            return {};
+        return e->type;
+    }
+
+    void testBuiltin()
+    {
+        mime_map const m;
+        BOOST_TEST_EQ(type(m, "index.html"), "text/html");
+        BOOST_TEST_EQ(type(m, "/var/www/INDEX.HTML"), "text/html");
+        BOOST_TEST_EQ(type(m, ".css"), "text/css");
+        BOOST_TEST_EQ(type(m, "js"), "text/javascript");
+        BOOST_TEST_EQ(type(m, "a.tar.gz"), "application/gzip");
+        BOOST_TEST_EQ(type(m, "x.7z"), "application/x-7z-compressed");
+        BOOST_TEST_EQ(type(m, "x.unknown"), "");
+        BOOST_TEST_EQ(type(m, "dir.d/file"), "");
+        BOOST_TEST_EQ(type(m, ""), "");
+
+        auto const* e = m.find("svg");
+        BOOST_TEST(e && e->compressible);
+        BOOST_TEST_EQ(m.content_type("a.json"),
+            "application/json; charset=UTF-8");
+        BOOST_TEST_EQ(m.content_type("a.png"), "image/png");
+        BOOST_TEST_EQ(m.content_type("a.nope"), "");
+
+        // mime_types uses the built-in map
+        BOOST_TEST_EQ(mime_types::lookup("x.7z"),
+            "application/x-7z-compressed");
+        BOOST_TEST_EQ(mime_types::lookup("STYLE.CSS"), "text/css");
+    }
+
+    void testMimeTypes()
+    {
+        auto const m = mime_map::from_mime_types(
+            "# comment\n"
+            "application/vnd.ms-excel\txls xlm\n"
+            "text/x-c c cc cxx  # C source\r\n"
+            "\n"
+            "application/ld+json jsonld\n"
+            "image/png PNG\n"
+            "notatype foo\n");
+        BOOST_TEST_EQ(type(m, "a.xls"), "application/vnd.ms-excel");
+        BOOST_TEST_EQ(type(m, "a.XLM"), "application/vnd.ms-excel");
+        BOOST_TEST_EQ(type(m, "main.cxx"), "text/x-c");
+        BOOST_TEST_EQ(type(m, "a.png"), "image/png");
+        BOOST_TEST_EQ(type(m, "a.foo"), "");
+        BOOST_TEST_EQ(type(m, "a.html"), "text/html");
+        BOOST_TEST_EQ(m.content_type("a.c"),
+            "text/x-c; charset=UTF-8");
+        BOOST_TEST(m.find("a.jsonld")->compressible);
+        BOOST_TEST(! m.find("a.xls")->compressible);
+        BOOST_TEST_EQ(m.size(), mime_map().size() + 6);
+    }
+
+    void testJson()
+    {
+        auto const m = mime_map::from_json(R"({
+            "application/vnd.foo": {
+                "source": "iana",
+                "charset": "UTF-8",
+                "compressible": true,
+                "extensions": ["foo", "Fo2"]
+            },
+            "application/x-bar": {
+                "extensions": ["bar"]
+            },
+            "application/x-none": {
+                "compressible": true
+            },
+            "text/css": {
+                "extensions": ["css", "less"]
+            }
+        })");
+        BOOST_TEST_EQ(type(m, "a.foo"), "application/vnd.foo");
+        BOOST_TEST_EQ(type(m, "a.fo2"), "application/vnd.foo");
+        BOOST_TEST_EQ(m.content_type("a.foo"),
+            "application/vnd.foo; charset=UTF-8");
+        BOOST_TEST(m.find("a.foo")->compressible);
+        BOOST_TEST_EQ(m.content_type("a.bar"), "application/x-bar");
+        BOOST_TEST(! m.find("a.bar")->compressible);
+        BOOST_TEST_EQ(type(m, "a.less"), "text/css");
+        BOOST_TEST_EQ(type(m, "a.gif"), "image/gif");
+
+        BOOST_TEST_THROWS(mime_map::from_json("[]"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(mime_map::from_json("{"),
+            std::invalid_argument);
+    }
+
+    void testLarge()
+    {
+        std::string s;
+        for(int i = 0; i < 2000; ++i)
+            s += "application/x-t" + std::to_string(i) +
+                " e" + std::to_string(i) + "\n";
+        auto const m = mime_map::from_mime_types(s);
+        for(int i = 0; i < 2000; ++i)
+            BOOST_TEST_EQ(type(m, "E" + std::to_string(i)),
+                "application/x-t" + std::to_string(i));
+    }
+
+    void run()
+    {
+        testBuiltin();
+        testMimeTypes();
+        testJson();
+        testLarge();
+    }
+};
+
+TEST_SUITE(
+    mime_map_test,
+    "boost.http.server.mime_map");
+
+} // http
+} // boost
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+#ifndef BOOST_HTTP_TEST_SERVER_PUMP_HPP
+#define BOOST_HTTP_TEST_SERVER_PUMP_HPP
+
+#include <boost/http/server/router_types.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/ex/run_async.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace boost {
+namespace http {
+
+// Resumes the coroutines posted to its executor,
+// from any thread, on the thread which calls run.
+// This stands in for the event loop of a connection.
+class pump
+{
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<capy::coro> q_;
+    std::thread::id id_;
+
+public:
+    // Coroutines posted from another thread
+    std::size_t foreign_posts = 0;
+
+    class executor_type
+    {
+        pump* p_;
+
+    public:
+        explicit
+        executor_type(pump& p) noexcept
+            : p_(&p)
+        {
+        }
+
+        bool
+        operator==(executor_type const& other) const noexcept
+        {
+            return p_ == other.p_;
+        }
+
+        struct context_type : capy::execution_context {};
+
+        capy::execution_context&
+        context() const noexcept
+        {
+            static context_type ctx;
+            return ctx;
+        }
+
+        void on_work_started() const noexcept {}
+        void on_work_finished() const noexcept {}
+
+        capy::coro
+        dispatch(capy::coro h) const noexcept
+        {
+            return h;
+        }
+
+        void
+        post(capy::coro h) const noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(p_->m_);
+                if(std::this_thread::get_id() != p_->id_)
+                    ++p_->foreign_posts;
+                p_->q_.push_back(h);
+            }
+            p_->cv_.notify_one();
+        }
+    };
+
+    executor_type
+    get_executor() noexcept
+    {
+        return executor_type(*this);
+    }
+
+    // Run the task to completion on this thread
+    route_result
+    run(route_task t)
+    {
+        id_ = std::this_thread::get_id();
+        route_result rv;
+        std::exception_ptr ep;
+        bool done = false;
+        capy::run_async(get_executor(),
+            [&](route_result v)
+            {
+                rv = v;
+                done = true;
+            },
+            [&](std::exception_ptr e)
+            {
+                ep = e;
+                done = true;
+            })(std::move(t));
+        while(! done)
+        {
+            std::unique_lock<std::mutex> lock(m_);
+            cv_.wait(lock, [this]{ return ! q_.empty(); });
+            auto h = q_.front();
+            q_.pop_front();
+            lock.unlock();
+            h.resume();
+        }
+        if(ep)
+            std::rethrow_exception(ep);
+        return rv;
+    }
+};
+
+static_assert(capy::Executor<pump::executor_type>);
+
+} // http
+} // boost
+
+#endif
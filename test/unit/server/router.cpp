@@ -444,6 +444,138 @@ struct router_test
         { test_router r; r.add(GET, "/auth/login", h_next); check(r, GET, "/auth%2flogin", route_next); }
     }
 
+    // checks captured params then returns success
+    static auto h_params(
+        std::initializer_list<std::pair<
+            core::string_view, core::string_view>> v)
+    {
+        std::vector<std::pair<std::string, std::string>> w;
+        for(auto const& pv : v)
+            w.emplace_back(pv.first, pv.second);
+        return [w](params& rp) -> route_result
+        {
+            BOOST_TEST_EQ(rp.param_count(), w.size());
+            if(rp.param_count() != w.size())
+                return {};
+            for(std::size_t i = 0; i < w.size(); ++i)
+            {
+                BOOST_TEST_EQ(rp.params()[i].name, w[i].first);
+                BOOST_TEST_EQ(rp.params()[i].value, w[i].second);
+                BOOST_TEST_EQ(rp.param(w[i].first), w[i].second);
+            }
+            return {};
+        };
+    }
+
+    void testParams()
+    {
+        static auto const GET = http::method::get;
+
+        // named params
+        { test_router r; r.add(GET, "/users/:id", h_params({{"id", "42"}})); check(r, GET, "/users/42"); }
+        { test_router r; r.add(GET, "/users/:id", h_send); check(r, GET, "/users", route_next); }
+        { test_router r; r.add(GET, "/users/:id", h_send); check(r, GET, "/users/42/x", route_next); }
+        { test_router r; r.add(GET, "/a/:x/b/:y", h_params({{"x", "1"}, {"y", "2"}})); check(r, GET, "/a/1/b/2"); }
+        { test_router r; r.add(GET, "/f/:name.:ext", h_params({{"name", "a.b"}, {"ext", "txt"}})); check(r, GET, "/f/a.b.txt"); }
+        { test_router r; r.add(GET, "/u/:id", h_params({{"id", "caf\xc3\xa9"}})); check(r, GET, "/u/caf%C3%A9"); }
+        { test_router r; r.add(GET, "/U/:id", h_params({{"id", "AbC"}})); check(r, GET, "/u/AbC"); }
+
+        // constraints
+        { test_router r; r.add(GET, "/n/:id(\\d+)", h_params({{"id", "123"}})); check(r, GET, "/n/123"); }
+        { test_router r; r.add(GET, "/n/:id(\\d+)", h_send); check(r, GET, "/n/12a", route_next); }
+        { test_router r; r.add(GET, "/n/:id(\\d{2,3})", h_send); check(r, GET, "/n/1234", route_next); }
+        { test_router r; r.add(GET, "/n/:id([a-f0-9]{4})", h_params({{"id", "beef"}})); check(r, GET, "/n/beef"); }
+        { test_router r; r.add(GET, "/n/:id([^.]+).json", h_params({{"id", "x"}})); check(r, GET, "/n/x.json"); }
+        BOOST_TEST_THROWS(test_router().add(GET, "/n/:id(a|b)", h_send), system::system_error);
+
+        // modifiers and wildcards
+        { test_router r; r.add(GET, "/u/:id?", h_params({})); check(r, GET, "/u"); }
+        { test_router r; r.add(GET, "/u/:id?", h_params({{"id", "7"}})); check(r, GET, "/u/7"); }
+        { test_router r; r.add(GET, "/f/:path+", h_params({{"path", "a/b/c"}})); check(r, GET, "/f/a/b/c"); }
+        { test_router r; r.add(GET, "/f/*rest", h_params({{"rest", "a/b"}})); check(r, GET, "/f/a/b"); }
+        { test_router r; r.add(GET, "/f/*rest", h_send); check(r, GET, "/f/", route_next); }
+
+        // middleware and nesting
+        { test_router r; r.use("/users/:id", h_params({{"id", "9"}})); check(r, "/users/9/posts"); }
+        {
+            test_router r;
+            r.use("/org/:org", []{
+                test_router r2;
+                r2.add(GET, "/repo/:repo", h_params({
+                    {"org", "boost"}, {"repo", "http"}}));
+                return r2;
+            }());
+            check(r, GET, "/org/boost/repo/http");
+        }
+
+        // backtracking is bounded by the path length
+        {
+            std::string path;
+            for(int i = 0; i < 5000; ++i)
+                path += "/y";
+            test_router r;
+            r.add(GET, "/*a/*b/*c/x", h_send);
+            r.add(GET, "/*a/:b+/x/:c*", h_send);
+            check(r, GET, path, route_next);
+        }
+        {
+            // a long path still matches in linear time
+            std::string path;
+            for(int i = 0; i < 5000; ++i)
+                path += "/y";
+            test_router r;
+            r.add(GET, "/*a/x", h_params({{"a", path.substr(1)}}));
+            check(r, GET, path + "/x");
+        }
+        { test_router r; r.add(GET, "/*a/*b/*c/x", h_params({{"a", "1/2"}, {"b", "3"}, {"c", "4"}})); check(r, GET, "/1/2/3/4/x"); }
+
+        // params of a failed sibling are discarded
+        {
+            test_router r;
+            r.add(GET, "/x/:a/y", h_send);
+            r.add(GET, "/x/:b", h_params({{"b", "1"}}));
+            check(r, GET, "/x/1");
+        }
+    }
+
+    void testSync()
+    {
+        static auto const GET = http::method::get;
+
+        auto sync_next = [](params&) { return route_next; };
+        auto sync_send = [](params&) -> route_result { return {}; };
+
+        { test_router r; r.use(sync_next); check(r, "/", route_next); }
+        { test_router r; r.use(sync_next, h_send); check(r, "/"); }
+        { test_router r; r.use(sync_next); r.use(sync_send); check(r, "/"); }
+        { test_router r; r.add(GET, "/", sync_send); check(r, GET, "/"); }
+        { test_router r; r.use(h_next, sync_next, h_send); check(r, "/"); }
+
+        // sync error handler
+        {
+            system::error_code const er = http::error::bad_connection;
+            test_router r;
+            r.use(h_fail(er));
+            r.use([er](params&, system::error_code ec) -> route_result
+            {
+                BOOST_TEST(ec == er);
+                return {};
+            });
+            check(r, "/");
+        }
+
+        // sync exception handler
+        {
+            test_router r;
+            r.use([](params&) -> route_result
+            {
+                throw std::runtime_error("test");
+            });
+            r.use([](params&, std::exception_ptr) { return route_done; });
+            check(r, "/");
+        }
+    }
+
     void run()
     {
         testUse();
@@ -454,6 +586,8 @@ struct router_test
         testOptions();
         testDispatch();
         testPathDecoding();
+        testSync();
+        testParams();
     }
 };
 
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http/server/router_types.hpp>
 #include <boost/http/server/basic_router.hpp>
+#include <boost/capy/ex/frame_allocator.hpp>
+#include <boost/capy/test/run_blocking.hpp>
 
 #include "test_suite.hpp"
 
@@ -18,9 +20,64 @@ namespace http {
 
 struct router_types_test
 {
+    static
+    route_task
+    answer(int n)
+    {
+        if(n > 0)
+            co_return route_next;
+        co_return route_done;
+    }
+
+    void
+    testFrameArena()
+    {
+        detail::frame_arena a;
+        std::pmr::memory_resource& mr = a;
+
+        // a freed frame is reused by the next
+        // frame of the same size class
+        void* p = mr.allocate(100);
+        mr.deallocate(p, 100);
+        void* q = mr.allocate(120);
+        BOOST_TEST(p == q);
+        mr.deallocate(q, 120);
+
+        // a different class gets different memory
+        void* r = mr.allocate(400);
+        BOOST_TEST(r != q);
+        mr.deallocate(r, 400);
+
+        // large frames bypass the free lists
+        void* big = mr.allocate(1 << 16);
+        mr.deallocate(big, 1 << 16);
+
+        // a copy shares nothing
+        detail::frame_arena b(a);
+        BOOST_TEST(! b.is_equal(a));
+
+        // the arena is capy's frame allocator in a scope
+        auto* const prev = capy::get_current_frame_allocator();
+        {
+            detail::frame_arena::scope s(a);
+            BOOST_TEST(capy::get_current_frame_allocator() == &a);
+            for(int i = 0; i < 3; ++i)
+            {
+                route_result rv;
+                capy::test::run_blocking(
+                    [&](route_result res) { rv = res; })(answer(i));
+                BOOST_TEST(rv.what() == (i > 0 ?
+                    route_what::next : route_what::done));
+            }
+        }
+        BOOST_TEST(capy::get_current_frame_allocator() == prev);
+    }
+
     void
     run()
     {
+        testFrameArena();
+
         // Test route_result construction and accessors
         {
             route_result r1(route_done);
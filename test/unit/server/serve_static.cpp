@@ -9,3 +9,884 @@
 
 // Test that header file is self-contained.
 #include <boost/http/server/serve_static.hpp>
+
+#include <boost/http/server/file_read_pool.hpp>
+#include <boost/http/server/range_parser.hpp>
+#include <boost/http/server/router.hpp>
+#include "src/server/detail/body_cache.hpp"
+#include "src/server/detail/file_cache.hpp"
+
+#include <boost/capy/test/run_blocking.hpp>
+#include "pump.hpp"
+#include "test_suite.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http {
+
+// A directory of files, removed on destruction
+class temp_dir
+{
+    std::filesystem::path path_;
+
+public:
+    temp_dir()
+    {
+        static int n = 0;
+        path_ = std::filesystem::temp_directory_path() /
+            ("boost_http_serve_static_" +
+                std::to_string(std::chrono::steady_clock::now()
+                    .time_since_epoch().count()) +
+                "_" + std::to_string(n++));
+        std::filesystem::create_directories(path_);
+    }
+
+    ~temp_dir()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    std::string
+    path() const
+    {
+        return path_.string();
+    }
+
+    std::string
+    add(
+        std::string const& name,
+        std::string const& body) const
+    {
+        auto const p = path_ / name;
+        std::filesystem::create_directories(p.parent_path());
+        std::ofstream(p, std::ios::binary) << body;
+        return p.string();
+    }
+};
+
+// A buffer sink which keeps the response body
+class body_sink
+{
+    std::string buf_;
+    std::size_t size_ = 0;
+
+public:
+    bool eof = false;
+
+    std::string
+    body() const
+    {
+        return buf_.substr(0, size_);
+    }
+
+    std::size_t
+    prepare(
+        capy::mutable_buffer* arr,
+        std::size_t max_count)
+    {
+        if(max_count == 0)
+            return 0;
+        if(buf_.size() - size_ < 4096)
+            buf_.resize(size_ + 4096);
+        arr[0] = capy::mutable_buffer(
+            &buf_[size_], buf_.size() - size_);
+        return 1;
+    }
+
+    capy::io_task<>
+    commit(std::size_t n)
+    {
+        return commit(n, false);
+    }
+
+    capy::io_task<>
+    commit(std::size_t n, bool end)
+    {
+        BOOST_TEST(! eof);
+        size_ += n;
+        eof = end;
+        co_return {};
+    }
+
+    capy::io_task<>
+    commit_eof()
+    {
+        BOOST_TEST(! eof);
+        eof = true;
+        co_return {};
+    }
+};
+
+// A file_body_sink which records each call, and
+// reads the range it is given from the file
+class file_sink : public file_body_sink
+{
+public:
+    struct call
+    {
+        std::uint64_t offset;
+        std::uint64_t n;
+        std::string data;
+    };
+
+    std::vector<call> calls;
+
+    capy::io_task<>
+    send_file(
+        file& f,
+        std::uint64_t offset,
+        std::uint64_t n) override
+    {
+        std::string data(static_cast<std::size_t>(n), 0);
+        f.seek(offset);
+        if(n > 0)
+            BOOST_TEST_EQ(f.read(&data[0], data.size()), data.size());
+        calls.push_back({ offset, n, std::move(data) });
+        co_return {};
+    }
+};
+
+// A file_reader which reads at once and hands back
+// the result when waited on. It can be told to fail,
+// or to stop at an offset as if the file had shrunk.
+class test_reader : public file_reader
+{
+    std::size_t n_ = 0;
+    system::error_code ec_;
+
+public:
+    std::size_t reads = 0;
+    std::uint64_t eof_at = static_cast<std::uint64_t>(-1);
+    bool fail = false;
+
+    void
+    start_read(
+        file& f,
+        std::uint64_t offset,
+        capy::mutable_buffer b) override
+    {
+        ++reads;
+        n_ = 0;
+        ec_ = {};
+        if(fail)
+        {
+            ec_ = make_error_code(system::errc::io_error);
+            return;
+        }
+        auto size = b.size();
+        if(offset >= eof_at)
+            size = 0;
+        else if(size > eof_at - offset)
+            size = static_cast<std::size_t>(eof_at - offset);
+        if(size == 0)
+            return;
+        f.seek(offset, ec_);
+        if(! ec_.failed())
+            n_ = f.read(b.data(), size, ec_);
+    }
+
+    capy::io_task<std::size_t>
+    wait_read() override
+    {
+        co_return { ec_, n_ };
+    }
+};
+
+struct serve_static_test
+{
+    using file_cache = detail::file_cache;
+
+    // The outcome of one request
+    struct reply
+    {
+        route_result rv;
+        http::response res;
+        std::string body;
+        bool eof = false;
+    };
+
+    // Run a GET for target, after setup adjusts
+    // the request and the route parameters. With
+    // a pump, reads finished on other threads are
+    // resumed on this one.
+    static reply
+    get(
+        serve_static const& ss,
+        std::string target,
+        std::function<void(route_params&)> setup = {},
+        pump* p = nullptr)
+    {
+        route_params rp;
+        body_sink sink;
+        rp.url = urls::url_view(target);
+        rp.req = request(method::get, target);
+        rp.res_body = capy::any_buffer_sink(sink);
+        if(setup)
+            setup(rp);
+        reply r;
+        if(p)
+            r.rv = p->run(ss(rp));
+        else
+            capy::test::run_blocking(
+                [&](route_result rv) { r.rv = rv; })(ss(rp));
+        r.res = rp.res;
+        r.body = sink.body();
+        r.eof = sink.eof;
+        return r;
+    }
+
+    static std::string
+    digits(std::size_t n)
+    {
+        std::string s;
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>('0' + i % 10));
+        return s;
+    }
+
+    static std::shared_ptr<file_cache::entry>
+    make_entry(std::string path)
+    {
+        auto e = std::make_shared<file_cache::entry>();
+        e->path = std::move(path);
+        e->found = true;
+        return e;
+    }
+
+    void testFileCacheHit()
+    {
+        file_cache c(8, std::chrono::seconds(60));
+        BOOST_TEST(c.find("/a") == nullptr);
+        auto e = make_entry("a");
+        c.insert("/a", e);
+        BOOST_TEST(c.find("/a") == e);
+        BOOST_TEST(c.find("/b") == nullptr);
+
+        // a new lookup replaces the entry
+        auto e2 = make_entry("a2");
+        c.insert("/a", e2);
+        BOOST_TEST(c.find("/a") == e2);
+    }
+
+    void testFileCacheExpiry()
+    {
+        file_cache c(8, std::chrono::seconds(0));
+        c.insert("/a", make_entry("a"));
+        BOOST_TEST(c.find("/a") == nullptr);
+    }
+
+    void testFileCacheEviction()
+    {
+        // least recently used goes first
+        file_cache c(2, std::chrono::seconds(60));
+        auto a = make_entry("a");
+        auto b = make_entry("b");
+        c.insert("/a", a);
+        c.insert("/b", b);
+        BOOST_TEST(c.find("/a") == a);
+        c.insert("/c", make_entry("c"));
+        BOOST_TEST(c.find("/b") == nullptr);
+        BOOST_TEST(c.find("/a") == a);
+        BOOST_TEST(c.find("/c") != nullptr);
+
+        // a request holding an evicted entry keeps it
+        c.insert("/d", make_entry("d"));
+        BOOST_TEST(c.find("/a") == nullptr);
+        BOOST_TEST(a->path == "a");
+    }
+
+    void testFileCacheDescriptor()
+    {
+        temp_dir dir;
+        auto const path = dir.add("a.txt", "hello");
+        auto e = make_entry(path);
+
+        file f;
+        BOOST_TEST(! e->acquire(f));
+        f.open(path.c_str(), file_mode::scan);
+        e->release(std::move(f));
+        BOOST_TEST(! f.is_open());
+
+        // one request at a time gets the descriptor
+        file f1;
+        file f2;
+        BOOST_TEST(e->acquire(f1));
+        BOOST_TEST(f1.is_open());
+        BOOST_TEST(! e->acquire(f2));
+
+        // it comes back for the next request
+        e->release(std::move(f1));
+        BOOST_TEST(e->acquire(f2));
+        char buf[5];
+        BOOST_TEST_EQ(f2.read(buf, sizeof(buf)), 5u);
+        BOOST_TEST_EQ(std::string(buf, 5), "hello");
+    }
+
+    void testFileBodySink()
+    {
+        temp_dir dir;
+        auto const content = digits(100);
+        dir.add("a.txt", content);
+        serve_static ss(dir.path());
+        file_sink fs;
+        auto const use_sink = [&](route_params& rp)
+        {
+            rp.res_file = &fs;
+        };
+
+        // the whole file
+        auto r = get(ss, "/a.txt", use_sink);
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST(r.res.status() == status::ok);
+        BOOST_TEST(r.body.empty());
+        BOOST_TEST_EQ(fs.calls.size(), 1u);
+        BOOST_TEST_EQ(fs.calls[0].offset, 0u);
+        BOOST_TEST_EQ(fs.calls[0].n, 100u);
+        BOOST_TEST_EQ(fs.calls[0].data, content);
+
+        // a single range
+        fs.calls.clear();
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            use_sink(rp);
+            rp.req.set(field::range, "bytes=10-19");
+        });
+        BOOST_TEST(r.res.status() == status::partial_content);
+        BOOST_TEST_EQ(r.res.value_or(field::content_range, ""),
+            "bytes 10-19/100");
+        BOOST_TEST_EQ(fs.calls.size(), 1u);
+        BOOST_TEST_EQ(fs.calls[0].offset, 10u);
+        BOOST_TEST_EQ(fs.calls[0].n, 10u);
+        BOOST_TEST_EQ(fs.calls[0].data, content.substr(10, 10));
+
+        // a suffix range
+        fs.calls.clear();
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            use_sink(rp);
+            rp.req.set(field::range, "bytes=-5");
+        });
+        BOOST_TEST_EQ(fs.calls.size(), 1u);
+        BOOST_TEST_EQ(fs.calls[0].offset, 95u);
+        BOOST_TEST_EQ(fs.calls[0].n, 5u);
+
+        // a multipart body is always copied
+        fs.calls.clear();
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            use_sink(rp);
+            rp.req.set(field::range, "bytes=0-1,50-51");
+        });
+        BOOST_TEST(r.res.status() == status::partial_content);
+        BOOST_TEST(fs.calls.empty());
+        BOOST_TEST(r.eof);
+
+        // without the sink the body is written
+        r = get(ss, "/a.txt");
+        BOOST_TEST_EQ(r.body, content);
+        BOOST_TEST(r.eof);
+    }
+
+    void testFileReader()
+    {
+        temp_dir dir;
+        auto const content = digits(40000);
+        auto const path = dir.add("a.txt", content);
+        serve_static ss(dir.path());
+        test_reader tr;
+        auto const use_reader = [&](route_params& rp)
+        {
+            rp.file_io = &tr;
+        };
+
+        // the whole file, in several reads
+        auto r = get(ss, "/a.txt", use_reader);
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST_EQ(r.body, content);
+        BOOST_TEST(r.eof);
+        BOOST_TEST_EQ(tr.reads, 3u);
+
+        // a single range
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            use_reader(rp);
+            rp.req.set(field::range, "bytes=20000-20009");
+        });
+        BOOST_TEST(r.res.status() == status::partial_content);
+        BOOST_TEST_EQ(r.body, content.substr(20000, 10));
+
+        // multipart matches the blocking reads
+        auto const multi = [&](route_params& rp)
+        {
+            rp.req.set(field::range, "bytes=0-1,17000-34999,-2");
+        };
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            use_reader(rp);
+            multi(rp);
+        });
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST_EQ(r.body, get(ss, "/a.txt", multi).body);
+        BOOST_TEST_EQ(r.res.payload_size(), r.body.size());
+        BOOST_TEST(r.eof);
+
+        // a read error fails the response
+        tr.fail = true;
+        r = get(ss, "/a.txt", use_reader);
+        BOOST_TEST(r.rv.what() == route_what::error);
+        BOOST_TEST(! r.eof);
+        tr.fail = false;
+
+        // so does a file shorter than its size
+        tr.eof_at = 20000;
+        r = get(ss, "/a.txt", use_reader);
+        BOOST_TEST(r.rv.what() == route_what::error);
+        BOOST_TEST(! r.eof);
+        BOOST_TEST_EQ(r.body, content.substr(0, 20000));
+        tr.eof_at = static_cast<std::uint64_t>(-1);
+
+        // and one which shrank under the blocking reads,
+        // while its size was cached
+        serve_static_options opts;
+        opts.cache_size = 8;
+        serve_static cached(dir.path(), opts);
+        BOOST_TEST_EQ(get(cached, "/a.txt").body, content);
+        std::filesystem::resize_file(path, 100);
+        r = get(cached, "/a.txt");
+        BOOST_TEST(r.rv.what() == route_what::error);
+        BOOST_TEST_EQ(r.body, content.substr(0, 100));
+        BOOST_TEST(! r.eof);
+    }
+
+    void testReadPool()
+    {
+        temp_dir dir;
+        auto const content = digits(100000);
+        auto const path = dir.add("a.txt", content);
+        dir.add("b.txt", "small");
+        file_read_pool pool(2);
+        BOOST_TEST_EQ(pool.max_threads(), 2u);
+        serve_static_options opts;
+        opts.read_pool = &pool;
+        serve_static ss(dir.path(), opts);
+
+        // the whole file, read on the pool and
+        // resumed on this thread
+        pump p;
+        auto r = get(ss, "/a.txt", {}, &p);
+        BOOST_TEST(r.rv.what() == route_what::done);
+        BOOST_TEST_EQ(r.body, content);
+        BOOST_TEST(r.eof);
+        BOOST_TEST(p.foreign_posts > 0);
+
+        // ranges match the blocking reads
+        auto const check = [&](
+            serve_static const& s,
+            std::string const& range,
+            std::function<void(route_params&)> setup = {})
+        {
+            auto const with_range = [&](route_params& rp)
+            {
+                if(setup)
+                    setup(rp);
+                rp.req.set(field::range, range);
+            };
+            pump p2;
+            auto const r2 = get(s, "/a.txt", with_range, &p2);
+            auto const r3 = get(serve_static(dir.path()), "/a.txt",
+                [&](route_params& rp) { rp.req.set(field::range, range); });
+            BOOST_TEST(r2.rv.what() == route_what::done);
+            BOOST_TEST(r2.res.status() == status::partial_content);
+            BOOST_TEST_EQ(r2.body, r3.body);
+            BOOST_TEST_EQ(r2.res.payload_size(), r2.body.size());
+            BOOST_TEST(r2.eof);
+        };
+        check(ss, "bytes=50000-50009");
+        check(ss, "bytes=0-1,17000-64999,-2");
+
+        // a reader given by the server is used instead
+        pooled_file_reader reader(pool);
+        auto const use_reader = [&](route_params& rp)
+        {
+            rp.file_io = &reader;
+        };
+        serve_static plain(dir.path());
+        r = get(plain, "/a.txt", use_reader, &p);
+        BOOST_TEST_EQ(r.body, content);
+        BOOST_TEST(r.eof);
+        check(plain, "bytes=0-1,17000-64999,-2", use_reader);
+
+        // small files are read into memory on the pool
+        opts.memory_cache_size = 4096;
+        serve_static mem(dir.path(), opts);
+        BOOST_TEST_EQ(get(mem, "/b.txt", {}, &p).body, "small");
+        BOOST_TEST_EQ(get(mem, "/b.txt").body, "small");
+
+        // a file which shrank after its size was
+        // cached fails the response
+        opts.memory_cache_size = 0;
+        opts.cache_size = 8;
+        serve_static cached(dir.path(), opts);
+        BOOST_TEST_EQ(get(cached, "/a.txt", {}, &p).body, content);
+        std::filesystem::resize_file(path, 100);
+        r = get(cached, "/a.txt", {}, &p);
+        BOOST_TEST(r.rv.what() == route_what::error);
+        BOOST_TEST_EQ(r.body, content.substr(0, 100));
+        BOOST_TEST(! r.eof);
+    }
+
+    void testPrecompressed()
+    {
+        temp_dir dir;
+        dir.add("a.txt", "plain");
+        dir.add("a.txt.br", "brotli");
+        dir.add("a.txt.gz", "gzip");
+        dir.add("b.txt", "only");
+
+        auto const check = [&](
+            serve_static const& ss,
+            core::string_view accept,
+            core::string_view body,
+            core::string_view coding)
+        {
+            auto r = get(ss, "/a.txt", [&](route_params& rp)
+            {
+                if(! accept.empty())
+                    rp.req.set(field::accept_encoding, accept);
+            });
+            BOOST_TEST(r.res.status() == status::ok);
+            BOOST_TEST_EQ(r.body, body);
+            BOOST_TEST_EQ(r.res.value_or(
+                field::content_encoding, ""), coding);
+            BOOST_TEST_EQ(r.res.value_or(field::vary, ""),
+                "Accept-Encoding");
+            BOOST_TEST_EQ(r.res.value_or(field::content_type, ""),
+                "text/plain; charset=UTF-8");
+            BOOST_TEST_EQ(r.res.payload_size(), body.size());
+        };
+
+        auto const check_all = [&](serve_static const& ss)
+        {
+            check(ss, "", "plain", "");
+            check(ss, "identity", "plain", "");
+            check(ss, "gzip", "gzip", "gzip");
+            check(ss, "x-gzip", "gzip", "gzip");
+            check(ss, "BR", "brotli", "br");
+
+            // brotli wins a tie
+            check(ss, "gzip, br", "brotli", "br");
+            check(ss, "*", "brotli", "br");
+
+            // q-values
+            check(ss, "gzip;q=1, br;q=0.5", "gzip", "gzip");
+            check(ss, "br;q=0.8, gzip;q=0.9", "gzip", "gzip");
+            check(ss, "br;q=0, gzip", "gzip", "gzip");
+            check(ss, "br;q=0, gzip;q=0", "plain", "");
+            check(ss, "*;q=0.5, gzip", "gzip", "gzip");
+            check(ss, "gzip ; q=0.001, *;q=0", "gzip", "gzip");
+        };
+
+        serve_static_options opts;
+        opts.precompressed = true;
+        check_all(serve_static(dir.path(), opts));
+
+        // the same through the file cache, twice, so
+        // the cached descriptors are reused
+        opts.cache_size = 8;
+        serve_static cached(dir.path(), opts);
+        check_all(cached);
+        check_all(cached);
+
+        // no Vary without a sibling
+        auto r = get(cached, "/b.txt", [](route_params& rp)
+        {
+            rp.req.set(field::accept_encoding, "br, gzip");
+        });
+        BOOST_TEST_EQ(r.body, "only");
+        BOOST_TEST(! r.res.exists(field::vary));
+        BOOST_TEST(! r.res.exists(field::content_encoding));
+
+        // siblings are ignored unless enabled
+        r = get(serve_static(dir.path()), "/a.txt",
+            [](route_params& rp)
+            {
+                rp.req.set(field::accept_encoding, "br, gzip");
+            });
+        BOOST_TEST_EQ(r.body, "plain");
+        BOOST_TEST(! r.res.exists(field::vary));
+    }
+
+    void testRanges()
+    {
+        temp_dir dir;
+        auto const content = digits(100);
+        dir.add("a.txt", content);
+        serve_static ss(dir.path());
+
+        auto const range = [&](
+            serve_static const& s,
+            std::string value)
+        {
+            return get(s, "/a.txt", [value](route_params& rp)
+            {
+                rp.req.set(field::range, value);
+            });
+        };
+
+        // overlapping and adjacent ranges merge
+        auto r = range(ss, "bytes=0-3,2-5,6-9");
+        BOOST_TEST(r.res.status() == status::partial_content);
+        BOOST_TEST_EQ(r.res.value_or(field::content_range, ""),
+            "bytes 0-9/100");
+        BOOST_TEST_EQ(r.body, content.substr(0, 10));
+
+        // out of order ranges merge too
+        r = range(ss, "bytes=50-59, 40-49");
+        BOOST_TEST_EQ(r.res.value_or(field::content_range, ""),
+            "bytes 40-59/100");
+
+        // multipart
+        r = range(ss, "bytes=0-1,50-52,-2");
+        BOOST_TEST(r.res.status() == status::partial_content);
+        auto const ct = r.res.value_or(field::content_type, "");
+        core::string_view const prefix =
+            "multipart/byteranges; boundary=";
+        BOOST_TEST(ct.starts_with(prefix));
+        std::string const boundary(ct.substr(prefix.size()));
+        BOOST_TEST(! boundary.empty());
+        auto const part = [&](
+            core::string_view cr,
+            core::string_view data)
+        {
+            return "\r\n--" + boundary + "\r\n"
+                "Content-Type: text/plain; charset=UTF-8\r\n"
+                "Content-Range: bytes " + std::string(cr) +
+                "/100\r\n\r\n" + std::string(data);
+        };
+        BOOST_TEST_EQ(r.body,
+            part("0-1", "01") +
+            part("50-52", "012") +
+            part("98-99", "89") +
+            "\r\n--" + boundary + "--\r\n");
+        BOOST_TEST_EQ(r.res.payload_size(), r.body.size());
+        BOOST_TEST(! r.res.exists(field::content_range));
+        BOOST_TEST(r.eof);
+
+        // the exact length also holds from memory
+        serve_static_options opts;
+        opts.memory_cache_size = 4096;
+        serve_static mem(dir.path(), opts);
+        for(int i = 0; i < 2; ++i)
+        {
+            auto const r2 = range(mem, "bytes=0-1,50-52,-2");
+            BOOST_TEST_EQ(r2.body.size(), r.body.size());
+            BOOST_TEST_EQ(r2.res.payload_size(), r2.body.size());
+        }
+
+        // unsatisfiable
+        r = range(ss, "bytes=200-300");
+        BOOST_TEST(r.res.status() == status::range_not_satisfiable);
+        BOOST_TEST_EQ(r.res.value_or(field::content_range, ""),
+            "bytes */100");
+    }
+
+    void testMaxRanges()
+    {
+        // parsing stops past the limit
+        auto rr = parse_range(100, "bytes=0-1,3-4,6-7", 2);
+        BOOST_TEST(rr.type == range_result_type::malformed);
+        BOOST_TEST(rr.ranges.empty());
+        rr = parse_range(100, "bytes=0-1,3-4", 2);
+        BOOST_TEST(rr.type == range_result_type::ok);
+        BOOST_TEST_EQ(rr.ranges.size(), 2u);
+        rr = parse_range(100, "bytes=0-1,3-4,6-7");
+        BOOST_TEST_EQ(rr.ranges.size(), 3u);
+
+        // too many ranges send the whole file
+        temp_dir dir;
+        auto const content = digits(100);
+        dir.add("a.txt", content);
+        serve_static ss(dir.path());
+        std::string many = "bytes=0-0";
+        for(int i = 1; i < 17; ++i)
+            many += "," + std::to_string(i * 2) + "-" +
+                std::to_string(i * 2);
+        auto r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            rp.req.set(field::range, many);
+        });
+        BOOST_TEST(r.res.status() == status::ok);
+        BOOST_TEST_EQ(r.body, content);
+
+        // sixteen are accepted
+        many = "bytes=0-0";
+        for(int i = 1; i < 16; ++i)
+            many += "," + std::to_string(i * 2) + "-" +
+                std::to_string(i * 2);
+        r = get(ss, "/a.txt", [&](route_params& rp)
+        {
+            rp.req.set(field::range, many);
+        });
+        BOOST_TEST(r.res.status() == status::partial_content);
+        BOOST_TEST_EQ(r.res.payload_size(), r.body.size());
+    }
+
+    void testBodyCache()
+    {
+        using detail::body_cache;
+        auto const body = [](std::size_t n, char c)
+        {
+            return std::make_shared<std::string const>(n, c);
+        };
+
+        // hits
+        {
+            body_cache c(100);
+            BOOST_TEST(c.find("/a", 10, 1) == nullptr);
+            auto const a = body(10, 'a');
+            c.insert("/a", 1, a);
+            BOOST_TEST(c.find("/a", 10, 1) == a);
+            BOOST_TEST(c.find("/b", 10, 1) == nullptr);
+        }
+
+        // eviction by total size, least recently used first
+        {
+            body_cache c(100);
+            auto const a = body(40, 'a');
+            auto const b = body(40, 'b');
+            c.insert("/a", 1, a);
+            c.insert("/b", 1, b);
+            BOOST_TEST(c.find("/a", 40, 1) == a);
+            c.insert("/c", 1, body(40, 'c'));
+            BOOST_TEST(c.find("/b", 40, 1) == nullptr);
+            BOOST_TEST(c.find("/a", 40, 1) == a);
+            BOOST_TEST(c.find("/c", 40, 1) != nullptr);
+
+            // one large body evicts several
+            auto const d = body(90, 'd');
+            c.insert("/d", 1, d);
+            BOOST_TEST(c.find("/a", 40, 1) == nullptr);
+            BOOST_TEST(c.find("/c", 40, 1) == nullptr);
+            BOOST_TEST(c.find("/d", 90, 1) == d);
+
+            // a body over the budget is not kept
+            c.insert("/e", 1, body(101, 'e'));
+            BOOST_TEST(c.find("/e", 101, 1) == nullptr);
+            BOOST_TEST(c.find("/d", 90, 1) == d);
+
+            // replacing a body frees its size
+            c.insert("/d", 2, body(10, 'x'));
+            c.insert("/f", 1, body(90, 'f'));
+            BOOST_TEST(c.find("/d", 10, 2) != nullptr);
+            BOOST_TEST(c.find("/f", 90, 1) != nullptr);
+        }
+
+        // a changed file drops its body
+        {
+            body_cache c(100);
+            c.insert("/a", 1, body(10, 'a'));
+            BOOST_TEST(c.find("/a", 10, 2) == nullptr);
+            BOOST_TEST(c.find("/a", 10, 1) == nullptr);
+            c.insert("/a", 1, body(10, 'a'));
+            BOOST_TEST(c.find("/a", 11, 1) == nullptr);
+            BOOST_TEST(c.find("/a", 10, 1) == nullptr);
+
+            // and its size is no longer counted
+            c.insert("/b", 1, body(100, 'b'));
+            BOOST_TEST(c.find("/b", 100, 1) != nullptr);
+        }
+    }
+
+    void testMemoryCache()
+    {
+        temp_dir dir;
+        auto const path = dir.add("a.txt", "first");
+        serve_static_options opts;
+        opts.memory_cache_size = 4096;
+        serve_static ss(dir.path(), opts);
+
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "first");
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "first");
+
+        // a new size is seen at once
+        dir.add("a.txt", "second");
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "second");
+
+        // so is a new modification time
+        dir.add("a.txt", "third!");
+        auto const t = std::filesystem::last_write_time(path);
+        std::filesystem::last_write_time(
+            path, t + std::chrono::hours(1));
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "third!");
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "third!");
+
+        // larger files are streamed
+        opts.memory_cache_max_file = 4;
+        serve_static small(dir.path(), opts);
+        BOOST_TEST_EQ(get(small, "/a.txt").body, "third!");
+    }
+
+    void testContainment()
+    {
+        temp_dir dir;
+        dir.add("secret.txt", "secret");
+        dir.add("www/a.txt", "public");
+        serve_static ss(dir.path() + "/www");
+
+        auto const refused = [&](std::string target)
+        {
+            auto const r = get(ss, std::move(target));
+            BOOST_TEST(r.rv.what() == route_what::next);
+            BOOST_TEST(r.body.empty());
+        };
+
+        BOOST_TEST_EQ(get(ss, "/a.txt").body, "public");
+        refused("/../secret.txt");
+        refused("/%2e%2e/secret.txt");
+        refused("/%2E%2E%2fsecret.txt");
+        refused("/a.txt%00.png");
+
+#if BOOST_HTTP_USE_POSIX_FILE
+        // links out of the root are not followed
+        auto const www = std::filesystem::path(dir.path()) / "www";
+        std::filesystem::create_symlink(
+            "../secret.txt", www / "file_link");
+        std::filesystem::create_symlink(
+            dir.path(), www / "dir_link");
+        refused("/file_link");
+        refused("/dir_link/secret.txt");
+#endif
+    }
+
+    void run()
+    {
+        testFileCacheHit();
+        testFileCacheExpiry();
+        testFileCacheEviction();
+        testFileCacheDescriptor();
+        testFileBodySink();
+        testFileReader();
+        testReadPool();
+        testPrecompressed();
+        testRanges();
+        testMaxRanges();
+        testBodyCache();
+        testMemoryCache();
+        testContainment();
+    }
+};
+
+TEST_SUITE(
+    serve_static_test,
+    "boost.http.server.serve_static");
+
+} // http
+} // boost
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/server/static_routes.hpp>
+
+#include <boost/http/server/basic_router.hpp>
+#include <boost/http/server/flat_router.hpp>
+
+#include <boost/capy/test/run_blocking.hpp>
+#include "test_suite.hpp"
+
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace http {
+
+struct static_routes_test
+{
+    using params = route_params_base;
+    using test_router = basic_router<params>;
+
+    static_assert(detail::is_literal_route("/", 1));
+    static_assert(detail::is_literal_route("/a/b/", 5));
+    static_assert(detail::is_literal_route("/a<b>", 5));
+    static_assert(detail::is_literal_route("/[a]", 4));
+    static_assert(! detail::is_literal_route("/a:b", 4));
+    static_assert(! detail::is_literal_route("/a*", 3));
+    static_assert(! detail::is_literal_route("/a{b}", 5));
+    static_assert(! detail::is_literal_route("/a(b)", 5));
+    static_assert(! detail::is_literal_route("", 0));
+    static_assert(! detail::is_literal_route("a", 1));
+    static_assert(! detail::is_literal_route("//", 2));
+    static_assert(! detail::is_literal_route("/:id", 4));
+    static_assert(! detail::is_literal_route("/a/*p", 5));
+    static_assert(! detail::is_literal_route("/%41", 4));
+    static_assert(! detail::is_literal_route("/a b", 4));
+
+    static void
+    dispatch(
+        test_router& r,
+        http::method verb,
+        core::string_view url,
+        route_result rv0 = route_done)
+    {
+        flat_router fr(std::move(r));
+        params req;
+        route_result rv;
+        capy::test::run_blocking([&](route_result res) { rv = res; })(
+            fr.dispatch(verb, urls::url_view(url), req));
+        BOOST_TEST(rv.what() == rv0.what());
+    }
+
+    static auto
+    h(std::shared_ptr<std::string> log, char c)
+    {
+        return [log, c](params&) -> route_result
+        {
+            log->push_back(c);
+            return route_done;
+        };
+    }
+
+    void testMatch()
+    {
+        auto const GET = http::method::get;
+        auto const POST = http::method::post;
+        auto log = std::make_shared<std::string>();
+        auto table = [&]
+        {
+            return static_routes(
+                static_route<"/">(GET, h(log, 'r')),
+                static_route<"/users">(GET, h(log, 'u')),
+                static_route<"/users">(POST, h(log, 'p')),
+                static_route<"/users/list/">(h(log, 'l')),
+                static_route<"/Items">(h(log, 'i')));
+        };
+        auto check = [&](
+            http::method verb,
+            core::string_view url,
+            core::string_view expect)
+        {
+            test_router r;
+            r.use(table());
+            log->clear();
+            dispatch(r, verb, url, expect.empty() ?
+                route_result(route_next) : route_result(route_done));
+            BOOST_TEST_EQ(*log, expect);
+        };
+
+        check(GET, "/", "r");
+        check(GET, "/users", "u");
+        check(POST, "/users", "p");
+        check(http::method::put, "/users", "");
+        check(GET, "/users/", "u");
+        check(GET, "/users/list", "l");
+        check(POST, "/users/list/", "l");
+        check(GET, "/user", "");
+        check(GET, "/usersx", "");
+        check(GET, "/users/x", "");
+
+        // case-insensitive by default
+        check(GET, "/USERS", "u");
+        check(GET, "/items", "i");
+        check(GET, "/ITEMS", "i");
+    }
+
+    void testOptions()
+    {
+        auto const GET = http::method::get;
+        auto log = std::make_shared<std::string>();
+        auto check = [&](
+            router_options opt,
+            core::string_view url,
+            core::string_view expect)
+        {
+            test_router r(opt);
+            r.use(static_routes(
+                static_route<"/a">(h(log, 'a')),
+                static_route<"/B/">(h(log, 'b'))));
+            log->clear();
+            dispatch(r, GET, url, expect.empty() ?
+                route_result(route_next) : route_result(route_done));
+            BOOST_TEST_EQ(*log, expect);
+        };
+
+        auto const cs = router_options().case_sensitive(true);
+        check(cs, "/a", "a");
+        check(cs, "/A", "");
+        check(cs, "/B", "b");
+        check(cs, "/b", "");
+
+        auto const st = router_options().strict(true);
+        check(st, "/a", "a");
+        check(st, "/a/", "");
+        check(st, "/b/", "b");
+        check(st, "/b", "");
+    }
+
+    void testMounted()
+    {
+        auto const GET = http::method::get;
+        auto log = std::make_shared<std::string>();
+
+        // matches the path relative to the mount point
+        {
+            test_router r;
+            r.use("/api", static_routes(
+                static_route<"/">(h(log, 'r')),
+                static_route<"/v1">(h(log, 'v'))));
+            log->clear();
+            dispatch(r, GET, "/api/v1");
+            BOOST_TEST_EQ(*log, "v");
+        }
+        {
+            test_router r;
+            r.use("/api", static_routes(
+                static_route<"/">(h(log, 'r'))));
+            log->clear();
+            dispatch(r, GET, "/api");
+            BOOST_TEST_EQ(*log, "r");
+        }
+
+        // falls through to the next handler
+        {
+            test_router r;
+            r.use(static_routes(
+                static_route<"/a">(h(log, 'a'))));
+            r.use(h(log, 'n'));
+            log->clear();
+            dispatch(r, GET, "/b");
+            BOOST_TEST_EQ(*log, "n");
+        }
+    }
+
+    void testAsync()
+    {
+        auto const GET = http::method::get;
+        auto log = std::make_shared<std::string>();
+
+        // a coroutine handler makes the table a coroutine
+        auto table = [&]
+        {
+            return static_routes(
+                static_route<"/a">(h(log, 'a')),
+                static_route<"/b">(
+                    [log](params&) -> route_task
+                    {
+                        log->push_back('b');
+                        co_return route_done;
+                    }));
+        };
+        static_assert(std::is_same_v<
+            decltype(table()(std::declval<params&>())), route_task>);
+        static_assert(std::is_same_v<
+            decltype(static_routes(static_route<"/a">(h(log, 'a')))(
+                std::declval<params&>())), route_result>);
+
+        auto check = [&](
+            core::string_view url,
+            core::string_view expect)
+        {
+            test_router r;
+            r.use(table());
+            log->clear();
+            dispatch(r, GET, url, expect.empty() ?
+                route_result(route_next) : route_result(route_done));
+            BOOST_TEST_EQ(*log, expect);
+        };
+
+        check("/a", "a");
+        check("/b", "b");
+        check("/c", "");
+    }
+
+    void run()
+    {
+        testMatch();
+        testOptions();
+        testMounted();
+        testAsync();
+    }
+};
+
+TEST_SUITE(
+    static_routes_test,
+    "boost.http.server.static_routes");
+
+} // http
+} // boost
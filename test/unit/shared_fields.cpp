@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2025 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http
+//
+
+// Test that header file is self-contained.
+#include <boost/http/shared_fields.hpp>
+
+#include <boost/http/response.hpp>
+#include <boost/http/serializer.hpp>
+#include <boost/http/static_response.hpp>
+
+#include <boost/capy/buffers/buffer_copy.hpp>
+
+#include "test_suite.hpp"
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace http {
+
+struct shared_fields_test
+{
+    void
+    testSpecial()
+    {
+        // shared_fields()
+        {
+            shared_fields sf;
+            BOOST_TEST(sf.empty());
+            BOOST_TEST_EQ(sf.buffer(), "\r\n");
+            BOOST_TEST_EQ(sf.use_count(), 0);
+            BOOST_TEST_EQ(sf.get().size(), 0);
+        }
+
+        // shared_fields(fields const&)
+        {
+            fields f;
+            f.append(field::server, "test");
+            f.append("X-Frame-Options", "DENY");
+            shared_fields const sf(f);
+            BOOST_TEST(! sf.empty());
+            BOOST_TEST_EQ(sf.buffer(), f.buffer());
+            BOOST_TEST_NE(
+                sf.buffer().data(), f.buffer().data());
+            BOOST_TEST_EQ(sf.use_count(), 1);
+
+            shared_fields sf2(sf);
+            BOOST_TEST_EQ(
+                sf2.buffer().data(), sf.buffer().data());
+            BOOST_TEST_EQ(sf.use_count(), 2);
+
+            shared_fields sf3;
+            sf3.swap(sf2);
+            BOOST_TEST(sf2.empty());
+            BOOST_TEST_EQ(
+                sf3.buffer().data(), sf.buffer().data());
+        }
+
+        // metadata fields are rejected
+        {
+            fields f;
+            f.append(field::content_length, "0");
+            BOOST_TEST_THROWS(
+                shared_fields{f},
+                std::invalid_argument);
+
+            fields f2;
+            f2.append(field::transfer_encoding, "chunked");
+            BOOST_TEST_THROWS(
+                shared_fields{f2},
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testResponse()
+    {
+        fields f;
+        f.append(field::server, "test");
+        shared_fields const sf(f);
+
+        // set_shared_fields
+        {
+            response res;
+            BOOST_TEST(res.get_shared_fields().empty());
+            res.set_shared_fields(sf);
+            BOOST_TEST_EQ(sf.use_count(), 2);
+            BOOST_TEST_EQ(
+                res.get_shared_fields().buffer().data(),
+                sf.buffer().data());
+
+            // the block is not part of the buffer
+            BOOST_TEST_EQ(
+                res.buffer(), "HTTP/1.1 200 OK\r\n\r\n");
+
+            // but lookups and iteration see it
+            BOOST_TEST(res.find(field::server) != res.end());
+            BOOST_TEST(res.exists(field::server));
+            BOOST_TEST(res.exists("Server"));
+            BOOST_TEST(! res.exists(field::age));
+            BOOST_TEST_EQ(res.count(field::server), 1);
+            BOOST_TEST_EQ(res.count("server"), 1);
+            BOOST_TEST_EQ(res.size(), 1);
+            BOOST_TEST_EQ(
+                res.value_or(field::server, ""), "test");
+            BOOST_TEST_EQ(
+                res.value_or("Server", ""), "test");
+            BOOST_TEST_EQ(
+                res.value_or(field::age, "none"), "none");
+            BOOST_TEST_EQ(res.at(field::server), "test");
+
+            // own fields shadow the block
+            res.set(field::server, "mine");
+            BOOST_TEST_EQ(
+                res.value_or(field::server, ""), "mine");
+            BOOST_TEST_EQ(res.count(field::server), 1);
+            BOOST_TEST_EQ(res.size(), 1);
+
+            // erasing uncovers the block
+            res.erase(field::server);
+            BOOST_TEST_EQ(
+                res.value_or(field::server, ""), "test");
+
+            // set only when missing
+            if(! res.exists(field::server))
+                res.set(field::server, "dup");
+            BOOST_TEST_EQ(
+                res.buffer(), "HTTP/1.1 200 OK\r\n\r\n");
+
+            res.set_shared_fields({});
+            BOOST_TEST(res.get_shared_fields().empty());
+            BOOST_TEST_EQ(sf.use_count(), 1);
+        }
+
+        // copy, move and swap
+        {
+            response res;
+            res.set_shared_fields(sf);
+
+            response res2(res);
+            BOOST_TEST_EQ(sf.use_count(), 3);
+
+            response res3(std::move(res2));
+            BOOST_TEST(res2.get_shared_fields().empty());
+            BOOST_TEST_EQ(sf.use_count(), 3);
+
+            response res4;
+            res4 = res3;
+            BOOST_TEST_EQ(sf.use_count(), 4);
+
+            res4.swap(res2);
+            BOOST_TEST(res4.get_shared_fields().empty());
+            BOOST_TEST(! res2.get_shared_fields().empty());
+        }
+        BOOST_TEST_EQ(sf.use_count(), 1);
+
+        // static_response
+        {
+            char buf[128];
+            static_response res(buf, sizeof(buf));
+            res.set_shared_fields(sf);
+            static_response res2(std::move(res));
+            BOOST_TEST(res.get_shared_fields().empty());
+            BOOST_TEST(! res2.get_shared_fields().empty());
+        }
+        BOOST_TEST_EQ(sf.use_count(), 1);
+    }
+
+    void
+    testOverlay()
+    {
+        fields f;
+        f.append(field::server, "test");
+        f.append(field::cache_control, "no-cache");
+        f.append("X-Frame-Options", "DENY");
+        f.append(field::vary, "Origin");
+        shared_fields const sf(f);
+
+        response res(status::ok);
+        res.set(field::content_type, "text/plain");
+        res.set(field::cache_control, "no-store");
+        res.set("x-frame-options", "SAMEORIGIN");
+        res.set_shared_fields(sf);
+
+        // callers holding the base see the same view
+        fields_base const& fb = res;
+        auto const names = [&fb]
+        {
+            std::string s;
+            for(auto const& v : fb)
+            {
+                s += v.name;
+                s += '=';
+                s += v.value;
+                s += ';';
+            }
+            return s;
+        };
+        core::string_view const expected =
+            "Content-Type=text/plain;"
+            "Cache-Control=no-store;"
+            "x-frame-options=SAMEORIGIN;"
+            "Server=test;"
+            "Vary=Origin;";
+        BOOST_TEST_EQ(names(), expected);
+        BOOST_TEST_EQ(fb.size(), 5);
+        BOOST_TEST_EQ(
+            std::distance(fb.begin(), fb.end()), 5);
+        BOOST_TEST_EQ(fb.count(field::cache_control), 1);
+        BOOST_TEST_EQ(fb.count("X-Frame-Options"), 1);
+        BOOST_TEST_EQ(fb.value_or(
+            field::cache_control, ""), "no-store");
+        BOOST_TEST_EQ(fb.value_or(
+            "X-Frame-Options", ""), "SAMEORIGIN");
+        BOOST_TEST_EQ(fb.value_or(field::vary, ""), "Origin");
+        BOOST_TEST(fb.exists(field::server));
+        BOOST_TEST(fb.find("vary")->value == "Origin");
+
+        // reverse iteration
+        {
+            std::string s;
+            for(auto it = fb.rbegin(); it != fb.rend(); ++it)
+                s += it->name.substr(0, 1);
+            BOOST_TEST_EQ(s, "VSxCC");
+            auto it = fb.end();
+            --it;
+            BOOST_TEST_EQ(it->name, "Vary");
+            --it;
+            BOOST_TEST_EQ(it->name, "Server");
+            --it;
+            BOOST_TEST_EQ(it->name, "x-frame-options");
+        }
+
+        // find_all sees one layer only
+        {
+            auto const r = fb.find_all(field::cache_control);
+            BOOST_TEST_EQ(std::distance(r.begin(), r.end()), 1);
+            BOOST_TEST(*r.begin() == "no-store");
+            auto const r2 = fb.find_all(field::server);
+            BOOST_TEST_EQ(std::distance(r2.begin(), r2.end()), 1);
+            BOOST_TEST(*r2.begin() == "test");
+        }
+
+        // shadowed fields are not serialized
+        {
+            serializer sr(make_serializer_config(
+                serializer_config{}));
+            res.set_content_length(0);
+            sr.start(res);
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto const cbs = sr.prepare().value();
+                auto const n = capy::buffer_size(cbs);
+                auto const n0 = s.size();
+                s.resize(n0 + n);
+                capy::buffer_copy(
+                    capy::mutable_buffer(&s[n0], n), cbs);
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(s,
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/plain\r\n"
+                "Cache-Control: no-store\r\n"
+                "x-frame-options: SAMEORIGIN\r\n"
+                "Content-Length: 0\r\n"
+                "Server: test\r\n"
+                "Vary: Origin\r\n"
+                "\r\n");
+            res.erase(field::content_length);
+        }
+
+        // own fields are inserted ahead of the block
+        {
+            response r(res);
+            auto it = r.insert(r.end(), "X-Id", "1");
+            BOOST_TEST_EQ(it->name, "X-Id");
+            BOOST_TEST_EQ((++it)->name, "Server");
+            r.erase(field::cache_control);
+            BOOST_TEST_EQ(
+                r.value_or(field::cache_control, ""),
+                "no-cache");
+            BOOST_TEST_EQ(r.size(), 6);
+            BOOST_TEST_EQ(r.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/plain\r\n"
+                "x-frame-options: SAMEORIGIN\r\n"
+                "X-Id: 1\r\n"
+                "\r\n");
+        }
+
+        // copies, moves and swaps see their own block
+        {
+            response r1(res);
+            BOOST_TEST_EQ(r1.value_or(field::server, ""), "test");
+            response r2;
+            r2 = r1;
+            response r3(std::move(r1));
+            BOOST_TEST(r1.find(field::server) == r1.end());
+            BOOST_TEST_EQ(r3.value_or(field::vary, ""), "Origin");
+            r3.set_shared_fields({});
+            BOOST_TEST(! r3.exists(field::server));
+            r3.swap(r2);
+            BOOST_TEST(! r2.exists(field::server));
+            BOOST_TEST(r3.exists(field::server));
+            BOOST_TEST_EQ(r3.size(), 5);
+
+            char buf[256];
+            static_response r4(buf, sizeof(buf));
+            r4 = res;
+            BOOST_TEST_EQ(r4.size(), 5);
+            static_response r5(std::move(r4));
+            BOOST_TEST_EQ(r5.value_or(field::server, ""), "test");
+            BOOST_TEST(! r4.exists(field::server));
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testResponse();
+        testOverlay();
+    }
+};
+
+TEST_SUITE(
+    shared_fields_test,
+    "boost.http.shared_fields");
+
+} // http
+} // boost